@@ -0,0 +1,93 @@
+/**
+ * @file feeCheck.c
+ * @brief This file contains a check and benchmark of the per-park table of
+ * partial-day fees. For every minute value from 0 to FEECHECKDAYS days, the
+ * fee calculateFee reads from the table of a park is compared with payment,
+ * which computes it quarter by quarter, and both are timed.
+ *
+ * Build and run from this directory:
+ *     gcc -O2 -o feeCheck feeCheck.c $(find .. -maxdepth 1 -name '*.c' \
+ *         ! -name project.c)
+ *     ./feeCheck
+ */
+
+// Include necessary libraries and header files
+#include <stdio.h>
+#include <time.h>
+#include "../parkingLot.h"
+
+#define FEECHECKDAYS 30 /**< The number of days of minute values checked. */
+#define FEECHECKROUNDS 20 /**< The number of timed passes over the values. */
+#define FEESETS 5 /**< The number of sets of fees checked. */
+
+/**
+ * @brief The sets of fees checked, initial, later and maximum, in
+ * thousandths of a cent.
+ */
+static const millicents feeSets[FEESETS][3] = {
+    {25000, 40000, 1500000}, // cheap, the cap reached late in the day
+    {100000, 200000, 2000000}, // the cap reached in a few hours
+    {125000, 333000, 1200500}, // three decimals
+    {1000, 1000, 1000}, // every quarter at the cap
+    {12345, 67891, 99999999} // the cap never reached
+};
+
+/**
+ * @brief Gets the time of a monotonic clock.
+ * @return double: The time in seconds.
+ */
+static double getSeconds(){
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Checks and times calculateFee against payment for a set of fees.
+ * @param fees The initial, later and maximum fee.
+ * @return int: The number of minute values whose fees differ.
+ */
+static int checkFeeSet(const millicents fees[3]){
+    parkingLot *park = createPark("check", 1, fees[0], fees[1], fees[2]);
+    long long minutes, last = (long long) FEECHECKDAYS * MINUTESINDAY;
+    volatile cents sink = 0; // keeps the timed calls from being dropped
+    double start, tableTime, paymentTime;
+    int mismatches = 0, round;
+
+    for (minutes = 0; minutes <= last; minutes++)
+        if (calculateFee(park, minutes) !=
+            roundToCents(payment(minutes, fees[0], fees[1], fees[2])))
+                mismatches++;
+
+    start = getSeconds();
+    for (round = 0; round < FEECHECKROUNDS; round++)
+        for (minutes = 0; minutes <= last; minutes++)
+            sink += calculateFee(park, minutes);
+    tableTime = getSeconds() - start;
+
+    start = getSeconds();
+    for (round = 0; round < FEECHECKROUNDS; round++)
+        for (minutes = 0; minutes <= last; minutes++)
+            sink += roundToCents(payment(minutes, fees[0], fees[1], fees[2]));
+    paymentTime = getSeconds() - start;
+
+    printf("%lld %lld %lld: %lld values, %d differ, table %.2f ns, "
+        "payment %.2f ns\n", fees[0], fees[1], fees[2], last + 1, mismatches,
+        tableTime * 1e9 / (FEECHECKROUNDS * (last + 1)),
+        paymentTime * 1e9 / (FEECHECKROUNDS * (last + 1)));
+    freePark(park);
+    return mismatches;
+}
+
+/**
+ * @brief The main function of the check.
+ * @return int: 0 if every fee matched, 1 otherwise.
+ */
+int main(){
+    int set, mismatches = 0;
+
+    for (set = 0; set < FEESETS; set++)
+        mismatches += checkFeeSet(feeSets[set]);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file inputBench.c
+ * @brief This file contains a benchmark of the reading of the input lines.
+ * A file is read line by line with fgets, with the inputReader mapping it,
+ * and with the inputReader reading it in blocks from a pipe, and the lines
+ * read per second are printed for each. Without a file, one of BENCHLINES
+ * commands is written to a temporary file first.
+ *
+ * Build and run from this directory:
+ *     gcc -O2 -o inputBench inputBench.c $(find .. -maxdepth 1 -name '*.c' \
+ *         ! -name project.c)
+ *     ./inputBench [ <input-file> ]
+ */
+
+// Include necessary libraries and header files
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../input.h"
+
+#define BENCHLINES 20000000 /**< The number of lines of a generated file. */
+
+/**
+ * @brief Gets the time of a monotonic clock.
+ * @return double: The time in seconds.
+ */
+static double getSeconds(){
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Writes a file of entries and exits of vehicles.
+ * @param path The path of the file.
+ */
+static void writeInput(char *path){
+    FILE *file = fopen(path, "w");
+    long line;
+
+    for (line = 0; line < BENCHLINES; line++)
+        fprintf(file, "%c Saldanha %02ld-%02ld-AA 01-03-2024 %02ld:%02ld\n",
+            line % 2 == 0 ? 'e' : 's', line / 2 % 100, line / 200 % 100,
+            line / 60 % 24, line % 60);
+    fclose(file);
+}
+
+/**
+ * @brief Prints the lines read per second of a way of reading.
+ * @param way The name of the way of reading.
+ * @param lines The number of lines read.
+ * @param bytes The sum of the first bytes of the lines.
+ * @param seconds The time taken.
+ */
+static void printRate(char *way, long lines, long bytes, double seconds){
+    printf("%-12s %ld lines (%ld), %.3f s, %.1fM lines/s\n", way, lines,
+        bytes, seconds, lines / seconds / 1e6);
+}
+
+/**
+ * @brief Reads a file line by line with fgets.
+ * @param path The path of the file.
+ */
+static void benchFgets(char *path){
+    FILE *file = fopen(path, "r");
+    char line[BUFSIZ];
+    long lines = 0, bytes = 0;
+    double start = getSeconds();
+
+    while (fgets(line, BUFSIZ, file) != NULL){
+        lines++;
+        bytes += line[0];
+    }
+    printRate("fgets", lines, bytes, getSeconds() - start);
+    fclose(file);
+}
+
+/**
+ * @brief Reads a file descriptor line by line with an inputReader.
+ * @param way The name of the way of reading.
+ * @param fd The file descriptor.
+ */
+static void benchReader(char *way, int fd){
+    double start = getSeconds();
+    inputReader *reader = createInputReader(fd);
+    long lines = 0, bytes = 0;
+    char *line;
+
+    while ((line = nextLine(reader)) != NULL){
+        lines++;
+        bytes += line[0];
+    }
+    freeInputReader(reader);
+    printRate(way, lines, bytes, getSeconds() - start);
+}
+
+/**
+ * @brief Reads a file from a pipe, written by a child process.
+ * @param path The path of the file.
+ */
+static void benchPipe(char *path){
+    char block[INPUTCHUNK / 16];
+    int ends[2], fd;
+    ssize_t bytesRead;
+
+    if (pipe(ends) != 0) return;
+    if (fork() == 0){
+        close(ends[0]);
+        fd = open(path, O_RDONLY);
+        while ((bytesRead = read(fd, block, sizeof(block))) > 0)
+            if (write(ends[1], block, bytesRead) != bytesRead) break;
+        _exit(0);
+    }
+    close(ends[1]);
+    benchReader("pipe", ends[0]);
+    close(ends[0]);
+    wait(NULL);
+}
+
+/**
+ * @brief The main function of the benchmark.
+ * @param argc The number of arguments.
+ * @param argv The arguments, the optional path of the file read.
+ * @return int: 0 if the file could be read, 1 otherwise.
+ */
+int main(int argc, char *argv[]){
+    char generated[] = "/tmp/inputBenchXXXXXX";
+    char *path = argc > 1 ? argv[1] : generated;
+    int fd;
+
+    if (argc <= 1){
+        if ((fd = mkstemp(generated)) < 0) return 1;
+        close(fd);
+        writeInput(generated);
+    }
+    if ((fd = open(path, O_RDONLY)) < 0){
+        fprintf(stderr, "cannot open %s\n", path);
+        return 1;
+    }
+
+    benchFgets(path);
+    benchReader("mapped", fd);
+    close(fd);
+    benchPipe(path);
+
+    if (argc <= 1) unlink(generated);
+    return 0;
+}
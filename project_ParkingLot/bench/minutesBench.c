@@ -0,0 +1,167 @@
+/**
+ * @file minutesBench.c
+ * @brief This file contains a microbenchmark of the conversion of dates and
+ * of differenceInMinutes, which minutesParked calls for every exit. Pairs of
+ * timestamps are drawn up to a number of years apart, converted from text
+ * and subtracted, and every difference is checked against a month by month
+ * count of the same calendar.
+ *
+ * Build and run from this directory:
+ *     gcc -O2 -o minutesBench minutesBench.c $(find .. -maxdepth 1 \
+ *         -name '*.c' ! -name project.c)
+ *     ./minutesBench
+ */
+
+// Include necessary libraries and header files
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../dateAndHour.h"
+
+#define BENCHPAIRS 1000000 /**< The number of pairs of timestamps timed. */
+#define BENCHRANGES 4 /**< The number of ranges of years timed. */
+
+/**
+ * @brief The greatest number of years between the two timestamps of a pair,
+ * for each range.
+ */
+static const int yearRanges[BENCHRANGES] = {0, 10, 1000, 6000};
+
+/**
+ * @brief The number of days of each month, every year has 365.
+ */
+static const int monthDays[MESES] = {
+    31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31
+};
+
+/**
+ * @brief A timestamp of a pair, as text and as the fields it was drawn from.
+ */
+typedef struct benchTime{
+    char dateText[32]; /**< The date, DD-MM-YYYY. */
+    char hourText[32]; /**< The hour, HH:MM. */
+    int year; /**< The year. */
+    int month; /**< The month, from 1 to 12. */
+    int day; /**< The day of the month. */
+    int minute; /**< The minute of the day. */
+}benchTime;
+
+/**
+ * @brief Gets the time of a monotonic clock.
+ * @return double: The time in seconds.
+ */
+static double getSeconds(){
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Draws a timestamp of a year.
+ * @param time Where the timestamp is stored.
+ * @param year The year.
+ */
+static void drawTime(benchTime *time, int year){
+    time->year = year;
+    time->month = rand() % MESES + 1;
+    time->day = rand() % monthDays[time->month - 1] + 1;
+    time->minute = rand() % MINUTESINDAY;
+    sprintf(time->dateText, "%02d-%02d-%04d", time->day, time->month, year);
+    sprintf(time->hourText, "%02d:%02d", time->minute / 60,
+        time->minute % 60);
+}
+
+/**
+ * @brief Counts the minutes from the start of year 1 to a timestamp, going
+ * through the years and the months like the code before the month table.
+ * @param time A pointer to the timestamp.
+ * @return long long: The number of minutes.
+ */
+static long long countMinutes(benchTime *time){
+    long long days = 0;
+    int year, month;
+
+    for (year = 1; year < time->year; year++) days += DAYSINYEAR;
+    for (month = 1; month < time->month; month++)
+        days += monthDays[month - 1];
+    days += time->day - 1;
+    return days * MINUTESINDAY + time->minute;
+}
+
+/**
+ * @brief Times the conversion and the differences of the pairs of a range.
+ * @param years The greatest number of years between two timestamps.
+ * @param oldTimes The older timestamps.
+ * @param newTimes The newer timestamps.
+ * @param logTimes Room for the converted timestamps, two per pair.
+ * @return long: The number of differences that did not match the count.
+ */
+static long benchRange(int years, benchTime *oldTimes, benchTime *newTimes,
+    dateAndHour *logTimes){
+
+    volatile long long sink = 0; // keeps the timed calls from being dropped
+    double start, convertTime, differenceTime;
+    long pair, mismatches = 0;
+    benchTime swap;
+    int year;
+
+    for (pair = 0; pair < BENCHPAIRS; pair++){
+        year = 1 + rand() % (MAXYEAR - 1 - years);
+        drawTime(&oldTimes[pair], year);
+        drawTime(&newTimes[pair], year + (years == 0 ? 0 : rand() % years));
+        if (countMinutes(&newTimes[pair]) < countMinutes(&oldTimes[pair])){
+            swap = oldTimes[pair];
+            oldTimes[pair] = newTimes[pair];
+            newTimes[pair] = swap;
+        }
+    }
+
+    start = getSeconds();
+    for (pair = 0; pair < BENCHPAIRS; pair++){
+        logTimes[2 * pair] = createDateAndHour(oldTimes[pair].dateText,
+            oldTimes[pair].hourText);
+        logTimes[2 * pair + 1] = createDateAndHour(newTimes[pair].dateText,
+            newTimes[pair].hourText);
+    }
+    convertTime = getSeconds() - start;
+
+    start = getSeconds();
+    for (pair = 0; pair < BENCHPAIRS; pair++)
+        sink += differenceInMinutes(logTimes[2 * pair + 1],
+            logTimes[2 * pair]);
+    differenceTime = getSeconds() - start;
+
+    for (pair = 0; pair < BENCHPAIRS; pair++)
+        if (differenceInMinutes(logTimes[2 * pair + 1], logTimes[2 * pair]) !=
+            countMinutes(&newTimes[pair]) - countMinutes(&oldTimes[pair]))
+                mismatches++;
+
+    printf("up to %d years: createDateAndHour %.1f ns, differenceInMinutes "
+        "%.1f ns, %ld differ\n", years, convertTime * 1e9 / (2 * BENCHPAIRS),
+        differenceTime * 1e9 / BENCHPAIRS, mismatches);
+    return mismatches;
+}
+
+/**
+ * @brief The main function of the benchmark.
+ * @return int: 0 if every difference matched, 1 otherwise.
+ */
+int main(){
+    benchTime *oldTimes = (benchTime*) malloc(sizeof(benchTime) * BENCHPAIRS);
+    benchTime *newTimes = (benchTime*) malloc(sizeof(benchTime) * BENCHPAIRS);
+    dateAndHour *logTimes =
+        (dateAndHour*) malloc(sizeof(dateAndHour) * 2 * BENCHPAIRS);
+    long mismatches = 0;
+    int range;
+
+    srand(2024);
+    for (range = 0; range < BENCHRANGES; range++)
+        mismatches += benchRange(yearRanges[range], oldTimes, newTimes,
+            logTimes);
+
+    free(oldTimes);
+    free(newTimes);
+    free(logTimes);
+    return mismatches == 0 ? 0 : 1;
+}
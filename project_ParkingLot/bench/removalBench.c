@@ -0,0 +1,146 @@
+/**
+ * @file removalBench.c
+ * @brief This file contains a benchmark of the removal of a park with many
+ * exits. A number of cars enter and leave a park once a day for a number of
+ * days, through the commands of the program, and then the park is removed
+ * with the r command, which is timed.
+ *
+ * Build and run from this directory:
+ *     gcc -O2 -o removalBench removalBench.c $(find .. -maxdepth 1 \
+ *         -name '*.c' ! -name project.c)
+ *     ./removalBench [ <cars> <days> ]
+ */
+
+// Include necessary libraries and project.c, with its main renamed
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#define main projectMain
+#include "../project.c"
+#undef main
+
+#define BENCHCARS 25000 /**< The number of cars, if not given. */
+#define BENCHDAYS 400 /**< The number of days, if not given. */
+#define BENCHYEAR 2024 /**< The year of the first day. */
+
+/**
+ * @brief The number of days of each month, every year has 365.
+ */
+static const int monthDays[MESES] = {
+    31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31
+};
+
+/**
+ * @brief Gets the time of a monotonic clock.
+ * @return double: The time in seconds.
+ */
+static double getSeconds(){
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Writes the date of a day as DD-MM-YYYY.
+ * @param text Where the date is written.
+ * @param day The number of the day, 0 for the first one.
+ */
+static void writeDate(char *text, int day){
+    int year = BENCHYEAR + day / DAYSINYEAR, month = 0;
+
+    day %= DAYSINYEAR;
+    while (day >= monthDays[month]) day -= monthDays[month++];
+    sprintf(text, "%02d-%02d-%04d", day + 1, month + 1, year);
+}
+
+/**
+ * @brief Runs a command of the program.
+ * @param allParks A pointer to the parkRegistry structure.
+ * @param allCars A pointer to the hashTable structure.
+ * @param format The format of the command, like printf.
+ * @param ... The values of the format.
+ */
+static void runCommand(parkRegistry *allParks, hashTable *allCars,
+    const char *format, ...){
+
+    char command[BUFSIZ];
+    va_list values;
+
+    va_start(values, format);
+    vsnprintf(command, BUFSIZ, format, values);
+    va_end(values);
+    doCommand(command, allParks, allCars);
+}
+
+/**
+ * @brief Enters and leaves the cars of a day.
+ * @param allParks A pointer to the parkRegistry structure.
+ * @param allCars A pointer to the hashTable structure.
+ * @param cars The number of cars.
+ * @param day The number of the day.
+ */
+static void runDay(parkRegistry *allParks, hashTable *allCars, int cars,
+    int day){
+
+    char dateText[32];
+    int car;
+
+    writeDate(dateText, day);
+    for (car = 0; car < cars; car++)
+        runCommand(allParks, allCars, "e Bench %c%c-%02d-AA %s 08:00\n",
+            'A' + car / 100 / 26 % 26, 'A' + car / 100 % 26, car % 100,
+            dateText);
+    for (car = 0; car < cars; car++)
+        runCommand(allParks, allCars, "s Bench %c%c-%02d-AA %s 18:00\n",
+            'A' + car / 100 / 26 % 26, 'A' + car / 100 % 26, car % 100,
+            dateText);
+}
+
+/**
+ * @brief The main function of the benchmark.
+ * @param argc The number of arguments.
+ * @param argv The arguments, the optional number of cars and of days.
+ * @return int: 0, or 1 if the numbers are not valid.
+ */
+int main(int argc, char *argv[]){
+    int cars = argc > 2 ? atoi(argv[1]) : BENCHCARS;
+    int days = argc > 2 ? atoi(argv[2]) : BENCHDAYS;
+    int output = dup(STDOUT_FILENO), day;
+    parkRegistry *allParks = createParkRegistry();
+    hashTable *allCars = createHashTable();
+    double start, fillTime, removalTime;
+    struct rusage usage;
+
+    if (cars <= 0 || cars > 26 * 26 * 100 || days <= 0 ||
+        days > (MAXYEAR - BENCHYEAR) * DAYSINYEAR){
+            fprintf(stderr, "invalid number of cars or days\n");
+            return 1;
+    }
+
+    // the answers are not part of the benchmark
+    dup2(open("/dev/null", O_WRONLY), STDOUT_FILENO);
+    initOutput();
+    start = getSeconds();
+    runCommand(allParks, allCars, "p Bench %d 0.25 0.40 15.00\n", cars);
+    runCommand(allParks, allCars, "p Other 10 0.25 0.40 15.00\n");
+    for (day = 0; day < days; day++) runDay(allParks, allCars, cars, day);
+    flushOutput();
+    fillTime = getSeconds() - start;
+
+    start = getSeconds();
+    runCommand(allParks, allCars, "r Bench\n");
+    removalTime = getSeconds() - start;
+    flushOutput();
+    dup2(output, STDOUT_FILENO);
+
+    getrusage(RUSAGE_SELF, &usage);
+    printf("%d cars, %d days, %ld exits: filled in %.2f s, r in %.2f ms, "
+        "peak RSS %ld MB\n", cars, days, (long) cars * days, fillTime,
+        removalTime * 1e3, usage.ru_maxrss / 1024);
+    return 0;
+}
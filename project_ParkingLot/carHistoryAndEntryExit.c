@@ -6,77 +6,148 @@
  * @date 29/03/2024
  */
 
-// Include necessary library and header file
-#include <stdlib.h>
+// Include necessary library and header files
+#include <string.h>
 #include "carHistoryAndEntryExit.h"
+#include "project.h"
 
 // Functions implementation
-carHistory *createCarHistory(dateAndHour *startTime, char *parkName){
-    carHistory *newCarHist = (carHistory*) malloc(sizeof(carHistory));
+carHistory *createCarHistory(parkingLot *park, dateAndHour startTime){
+    carHistory *newCarHist = (carHistory*) arenaAllocate(getParkArena(park),
+        sizeof(carHistory));
+
+    newCarHist->parkName = getParkName(park);
+    newCarHist->park = park;
+    newCarHist->tickets = NULL;
+    newCarHist->ticketCount = 0;
+    newCarHist->ticketSize = 0;
+    newCarHist->lastStored = 0;
+    newCarHist->storedCount = 0;
+    newCarHist->visitorIndex = 0;
+    putNewEntryInCarHistory(newCarHist, startTime);
 
-    newCarHist->parkName = parkName;
-    newCarHist -> carInOutLog = createList();
-    addItem(newCarHist->carInOutLog,
-        createInfo(createEntryAndExit(startTime), ISENTRYANDEXIT));
+    return newCarHist;
+}
+
+carHistory *restoreCarHistory(parkingLot *park, entryAndExit *tickets,
+    int count){
+
+    memoryArena *arena = getParkArena(park);
+    carHistory *newCarHist =
+        (carHistory*) arenaAllocate(arena, sizeof(carHistory));
+
+    newCarHist->parkName = getParkName(park);
+    newCarHist->park = park;
+    for (newCarHist->ticketSize = INITIALTICKETS;
+        newCarHist->ticketSize < count; newCarHist->ticketSize *= 2);
+    newCarHist->tickets = (entryAndExit*) arenaAllocate(arena,
+        sizeof(entryAndExit) * newCarHist->ticketSize);
+    if (count > 0) // all of them may be in the history store
+        memcpy(newCarHist->tickets, tickets, sizeof(entryAndExit) * count);
+    newCarHist->ticketCount = count;
+    newCarHist->lastStored = 0;
+    newCarHist->storedCount = 0;
+    newCarHist->visitorIndex = 0;
 
     return newCarHist;
 }
 
-entryAndExit *createEntryAndExit(dateAndHour *entry){
-    entryAndExit *newEntryLog = (entryAndExit*) malloc(sizeof(entryAndExit));
+void freeCarHistory(carHistory *carHist){
+    memoryArena *arena = getParkArena(carHist->park);
 
-    newEntryLog->entry = entry;
-    newEntryLog->exit = NULL;
-    newEntryLog->Payedfee = 0;
-    return newEntryLog;
+    if (carHist->tickets != NULL)
+        arenaRelease(arena, carHist->tickets,
+            sizeof(entryAndExit) * carHist->ticketSize);
+    arenaRelease(arena, carHist, sizeof(carHistory));
 }
 
 char *getCarHistoryName(carHistory *carHist){
     return carHist->parkName;
 }
 
-list *getCarInOutLog(carHistory *carHist){
-    return carHist->carInOutLog;
+parkingLot *getCarHistoryPark(carHistory *carHist){
+    return carHist->park;
 }
 
-dateAndHour *getEntry(entryAndExit *ticket){
-    return ticket->entry;
+int getCarHistoryVisitor(carHistory *carHist){
+    return carHist->visitorIndex;
 }
 
-dateAndHour *getExit(entryAndExit *ticket){
-    return ticket->exit;
+void changeCarHistoryVisitor(carHistory *carHist, int visitorIndex){
+    carHist->visitorIndex = visitorIndex;
 }
 
-dateAndHour *getCarHistoryLastEntry(carHistory *carHist){
-    info *ticket = getLastItem(getCarInOutLog(carHist));
+long getCarHistoryBytes(carHistory *carHist){
+    return sizeof(carHistory) + sizeof(entryAndExit) * carHist->ticketSize;
+}
 
-    return getEntry(getEntryAndExitInfo(ticket));
+int getCarHistoryTicketCount(carHistory *carHist){
+    return carHist->ticketCount;
 }
 
-double getPayedFee(entryAndExit *ticket){
-    return ticket->Payedfee;
+int getCarHistoryStoredCount(carHistory *carHist){
+    return carHist->storedCount;
 }
 
-void putNewEntryInCarHistory(carHistory *carHist, dateAndHour *time){
-    addItem(getCarInOutLog(carHist),
-        createInfo(createEntryAndExit(time), ISENTRYANDEXIT));
+long getCarHistoryLastStored(carHistory *carHist){
+    return carHist->lastStored;
 }
 
-void putNewExitInCarHistory(carHistory *carHist, dateAndHour *time, double fee){
-    entryAndExit *ticket;
+void changeCarHistoryStored(carHistory *carHist, int storedCount,
+    long lastStored){
 
-    ticket = getEntryAndExitInfo(getLastItem(getCarInOutLog(carHist)));
-    ticket->exit = time;
-    ticket->Payedfee = fee;
+    carHist->storedCount = storedCount;
+    carHist->lastStored = lastStored;
 }
 
-void freeCarHistory(carHistory *carHist){
-    freeList(getCarInOutLog(carHist));
-    free(carHist);
+void moveLastTicketToStore(carHistory *carHist, long offset){
+    carHist->ticketCount--; // its slot is used by the next entry
+    carHist->storedCount++;
+    carHist->lastStored = offset;
+}
+
+entryAndExit *getCarHistoryTicket(carHistory *carHist, int position){
+    return &carHist->tickets[position];
+}
+
+dateAndHour getEntry(entryAndExit *ticket){
+    return ticket->entry;
+}
+
+dateAndHour getExit(entryAndExit *ticket){
+    return ticket->exit;
+}
+
+entryAndExit *getCarHistoryLastTicket(carHistory *carHist){
+    if (carHist->ticketCount == 0) return NULL;
+    return getCarHistoryTicket(carHist, carHist->ticketCount - 1);
 }
 
-void freeEntryAndExit(entryAndExit *ticket){
-    freeDateAndHour(getEntry(ticket));
-    free(getExit(ticket));
-    free(ticket);
+cents getPayedFee(entryAndExit *ticket){
+    return ticket->Payedfee;
+}
+
+entryAndExit *putNewEntryInCarHistory(carHistory *carHist, dateAndHour time){
+    entryAndExit *ticket;
+    int newSize;
+
+    if (carHist->ticketCount == carHist->ticketSize){ // the array is full
+        newSize = carHist->ticketSize == 0 ? INITIALTICKETS :
+            carHist->ticketSize * 2;
+        carHist->tickets = (entryAndExit*) arenaGrow(
+            getParkArena(carHist->park), carHist->tickets,
+            sizeof(entryAndExit) * carHist->ticketSize,
+            sizeof(entryAndExit) * newSize);
+        carHist->ticketSize = newSize;
+    }
+    ticket = &carHist->tickets[carHist->ticketCount++];
+    ticket->entry = time;
+    ticket->exit = INVALIDTIME;
+    ticket->Payedfee = 0;
+    return ticket;
+}
+
+void putExitInTicket(entryAndExit *ticket, dateAndHour time, cents fee){
+    ticket->exit = time;
+    ticket->Payedfee = fee;
 }
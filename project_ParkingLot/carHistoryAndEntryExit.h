@@ -12,20 +12,12 @@
 
 // Include header files
 #include "dateAndHour.h"
-#include "list.h"
+#include "memoryArena.h"
 
-/**
- * @struct carHistory
- * @brief A structure to represent a vehicle's parking history in a
- * specific park. This structure represents a vehicle's parking history in a
- * specific park with the total fee paid.
- */
-typedef struct carHistory{
-    char *parkName; /**< The name of the park. */
-    list *carInOutLog; /**< A list of the vehicle's entry and exit
-        times and fees for that park. */
-    double payedFee; /**< The total fee paid by the vehicle for this park. */
-}carHistory;
+#define INITIALTICKETS 2 /**< The initial number of tickets of a history. */
+
+// Forward declaration of structure
+typedef struct parkingLot parkingLot;
 
 /**
  * @struct entryAndExit
@@ -34,31 +26,65 @@ typedef struct carHistory{
  * and exit times and the fee paid for a specific parking.
  */
 typedef struct entryAndExit{
-    dateAndHour *entry; /**< The entry time of the vehicle. */
-    dateAndHour *exit; /**< The exit time of the vehicle. */
-    double Payedfee; /**< The fee paid by the vehicle for this parking. */
+    dateAndHour entry; /**< The entry time of the vehicle. */
+    dateAndHour exit; /**< The exit time of the vehicle, INVALIDTIME while
+        the vehicle is parked. */
+    cents Payedfee; /**< The fee paid by the vehicle for this parking. */
 }entryAndExit;
 
+/**
+ * @struct carHistory
+ * @brief A structure to represent a vehicle's parking history in a
+ * specific park. This structure represents a vehicle's parking history in a
+ * specific park. The history and its tickets belong to the arena of the
+ * park, so they are freed with the park. When there is a history store, the
+ * completed tickets are moved to it, and only the ticket of the current
+ * parking stays in the array.
+ */
+typedef struct carHistory{
+    char *parkName; /**< The name of the park. */
+    parkingLot *park; /**< The park, with the arena of the history. */
+    entryAndExit *tickets; /**< The vehicle's entry and exit times and fees
+        for that park, by order of entry. */
+    int ticketCount; /**< The number of tickets. */
+    int ticketSize; /**< The number of tickets that fit in the array. */
+    long lastStored; /**< The offset of the newest ticket in the history
+        store, 0 if there is none. */
+    int storedCount; /**< The number of tickets in the history store, all
+        older than the ones of the array. */
+    int visitorIndex; /**< The position of the vehicle in the visitors of the
+        park. */
+}carHistory;
+
 /**
  * @brief Creates a new carHistory structure.
- * This function allocates memory for a new carHistory structure and initializes
- * it with the given parameters. It also creates a list for the car's entry and
- * exit log and adds an entry for the current parking.
+ * This function takes a new carHistory structure from the arena of the park
+ * and initializes it with the given parameters. It also adds a ticket for the
+ * current parking.
+ * @param park The parking lot.
  * @param startTime The date and hour of vehicle entry.
- * @param parkName The name of the parking lot.
  * @return carHistory*: A pointer to the created carHistory structure.
  */
-carHistory *createCarHistory(dateAndHour *startTime, char *parkName);
+carHistory *createCarHistory(parkingLot *park, dateAndHour startTime);
 
 /**
- * @brief Creates a new entryAndExit structure.
- * This function allocates memory for a new entryAndExit structure and
- * initializes it with the given parameters. The exit time and the paid fee are
- * initially set to NULL and 0 respectively.
- * @param entry The date and hour of vehicle entry.
- * @return entryAndExit*: A pointer to the created entryAndExit structure.
+ * @brief Creates a carHistory structure with the tickets of a saved history.
+ * The tickets are copied in one block to an array of the arena of the park,
+ * with the size it would have after adding them one by one.
+ * @param park The parking lot.
+ * @param tickets The entry and exit logs, by order of entry.
+ * @param count The number of tickets, 0 if they are all in the store.
+ * @return carHistory*: A pointer to the created carHistory structure.
  */
-entryAndExit *createEntryAndExit(dateAndHour *entry);
+carHistory *restoreCarHistory(parkingLot *park, entryAndExit *tickets,
+    int count);
+
+/**
+ * @brief Gives a carHistory structure and its tickets back to the arena of
+ * its park, to be used by other histories.
+ * @param carHist The car history.
+ */
+void freeCarHistory(carHistory *carHist);
 
 /**
  * @brief Gets the name of the park in car history.
@@ -68,71 +94,128 @@ entryAndExit *createEntryAndExit(dateAndHour *entry);
 char *getCarHistoryName(carHistory *carHist);
 
 /**
- * @brief Gets the car in and out log of the car history.
+ * @brief Gets the park of the car history.
  * @param carHist The car history.
- * @return list*: The car in and out log.
+ * @return parkingLot*: The park.
  */
-list *getCarInOutLog(carHistory *carHist);
+parkingLot *getCarHistoryPark(carHistory *carHist);
+
+/**
+ * @brief Gets the position of the vehicle in the visitors of the park of the
+ * car history.
+ * @param carHist The car history.
+ * @return int: The position in the visitors.
+ */
+int getCarHistoryVisitor(carHistory *carHist);
+
+/**
+ * @brief Changes the position of the vehicle in the visitors of the park of
+ * the car history.
+ * @param carHist The car history.
+ * @param visitorIndex The new position in the visitors.
+ */
+void changeCarHistoryVisitor(carHistory *carHist, int visitorIndex);
+
+/**
+ * @brief Gets the bytes the car history takes in the arena of its park.
+ * @param carHist The car history.
+ * @return long: The bytes of the structure and of its array of tickets.
+ */
+long getCarHistoryBytes(carHistory *carHist);
+
+/**
+ * @brief Gets the number of tickets of the car history.
+ * @param carHist The car history.
+ * @return int: The number of tickets.
+ */
+int getCarHistoryTicketCount(carHistory *carHist);
+
+/**
+ * @brief Gets the number of tickets of the car history in the history store.
+ * @param carHist The car history.
+ * @return int: The number of stored tickets.
+ */
+int getCarHistoryStoredCount(carHistory *carHist);
+
+/**
+ * @brief Gets the offset of the newest ticket of the car history in the
+ * history store.
+ * @param carHist The car history.
+ * @return long: The offset of the record, 0 if there is none.
+ */
+long getCarHistoryLastStored(carHistory *carHist);
+
+/**
+ * @brief Changes the tickets of the car history in the history store.
+ * @param carHist The car history.
+ * @param storedCount The number of stored tickets.
+ * @param lastStored The offset of the newest of them, 0 if there is none.
+ */
+void changeCarHistoryStored(carHistory *carHist, int storedCount,
+    long lastStored);
+
+/**
+ * @brief Drops the last ticket of the car history, once it is in the
+ * history store.
+ * @param carHist The car history.
+ * @param offset The offset of the record of the ticket in the store.
+ */
+void moveLastTicketToStore(carHistory *carHist, long offset);
+
+/**
+ * @brief Gets a ticket of the car history.
+ * The ticket may move when a new entry is added to the history.
+ * @param carHist The car history.
+ * @param position The position of the ticket, from 0, by order of entry.
+ * @return entryAndExit*: The ticket.
+ */
+entryAndExit *getCarHistoryTicket(carHistory *carHist, int position);
 
 /**
  * @brief Gets the entry date and hour of the entry and exit log.
  * @param ticket The entry and exit log.
- * @return dateAndHour*: The entry date and hour.
+ * @return dateAndHour: The entry date and hour.
  */
-dateAndHour *getEntry(entryAndExit *ticket);
+dateAndHour getEntry(entryAndExit *ticket);
 
 /**
  * @brief Gets the exit date and hour of the entry and exit log.
  * @param ticket The entry and exit log.
- * @return dateAndHour*: The exit date and hour.
+ * @return dateAndHour: The exit date and hour, INVALIDTIME if the vehicle
+ * didn't leave yet.
  */
-dateAndHour *getExit(entryAndExit *ticket);
+dateAndHour getExit(entryAndExit *ticket);
 
 /**
- * @brief Gets the last entry of the car history.
+ * @brief Gets the last entry and exit log of the car history.
  * @param carHist The car history.
- * @return dateAndHour*: The last entry.
+ * @return entryAndExit*: The last entry and exit log, NULL if the array has
+ * none.
  */
-dateAndHour *getCarHistoryLastEntry(carHistory *carHist);
+entryAndExit *getCarHistoryLastTicket(carHistory *carHist);
 
 /**
  * @brief Gets the payed fee of the entry and exit log.
  * @param ticket The entry and exit log.
- * @return double: The payed fee.
+ * @return cents: The payed fee.
  */
-double getPayedFee(entryAndExit *ticket);
+cents getPayedFee(entryAndExit *ticket);
 
 /**
  * @brief Puts a new entry in the car history.
+ * The previous tickets may move to a larger array of the arena.
  * @param carHist The car history.
  * @param time The entry date and hour.
+ * @return entryAndExit*: The new entry and exit log.
  */
-void putNewEntryInCarHistory(carHistory *carHist, dateAndHour *time);
+entryAndExit *putNewEntryInCarHistory(carHistory *carHist, dateAndHour time);
 
 /**
- * @brief Updates the car history with a new exit time and fee.
- * This function updates the last entry in the car history with
- * the provided exit time and fee.
- * @param carHist The car history to update.
+ * @brief Updates an entry and exit log with its exit time and fee.
+ * @param ticket The entry and exit log to update.
  * @param time The exit time.
  * @param fee The fee paid.
  */
-void putNewExitInCarHistory(carHistory *carHist, dateAndHour *time, double fee);
-
-/**
- * @brief Frees the memory allocated for the car history.
- * This function frees the memory allocated for the car history
- * and its associated in and out log.
- * @param carHist The car history to free.
- */
-void freeCarHistory(carHistory *carHist);
-
-/**
- * @brief Frees the memory allocated for the entry and exit ticket.
- * This function frees the memory allocated for the entry and exit
- * ticket and its associated dates.
- * @param ticket The entry and exit ticket to free.
- */
-void freeEntryAndExit(entryAndExit *ticket);
+void putExitInTicket(entryAndExit *ticket, dateAndHour time, cents fee);
 
 #endif
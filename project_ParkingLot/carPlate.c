@@ -0,0 +1,75 @@
+/**
+ * @file carPlate.c
+ * @brief This file contains the implementation of the
+ * licence plate related functions.
+ */
+
+// Include necessary header files
+#include "carPlate.h"
+#include "output.h"
+
+#define DIGITPAIRS 100 /**< The number of pairs with two digits. */
+#define LETTERS 26 /**< The number of uppercase letters. */
+
+/**
+ * @brief Reads a pair of a plate.
+ * @param pair The first character of the pair.
+ * @param hasNumbers Set to TRUE if the pair has two digits.
+ * @param hasLetters Set to TRUE if the pair has two uppercase letters.
+ * @return int: The code of the pair, -1 if the pair is not valid.
+ */
+static int readPair(char *pair, int *hasNumbers, int *hasLetters){
+    if (pair[0] >= '0' && pair[0] <= '9' && pair[1] >= '0' && pair[1] <= '9'){
+        *hasNumbers = TRUE;
+        return (pair[0] - '0') * 10 + (pair[1] - '0');
+    }
+    if (pair[0] >= 'A' && pair[0] <= 'Z' && pair[1] >= 'A' && pair[1] <= 'Z'){
+        *hasLetters = TRUE;
+        return DIGITPAIRS + (pair[0] - 'A') * LETTERS + (pair[1] - 'A');
+    }
+    return -1;
+}
+
+plate createCarPlate(char *plateString){
+    int pos, pairCode, hasNumbers = FALSE, hasLetters = FALSE;
+    plate carPlate = 0;
+
+    for(pos = 0; pos <= 6; pos += 3){ // carPlate is like : xx-xx-xx\0
+        if ((pairCode = readPair(plateString + pos, &hasNumbers,
+            &hasLetters)) < 0)
+                return INVALIDPLATE;
+
+        if (plateString[pos + 2] != (pos < 6 ? '-' : '\0'))
+            return INVALIDPLATE;
+
+        carPlate = carPlate * PLATEPAIRS + pairCode;
+    }
+    // invalid if it has 3 equal type of pairs
+    if (!hasNumbers || !hasLetters) return INVALIDPLATE;
+    return carPlate;
+}
+
+int isValidCarPlate(plate carPlate){
+    return carPlate != INVALIDPLATE;
+}
+
+void printCarPlate(plate carPlate){
+    char text[CARPLATE];
+    int pos, pairCode;
+
+    for(pos = 6; pos >= 0; pos -= 3){ // the last pair is the lowest digit
+        pairCode = carPlate % PLATEPAIRS;
+        carPlate /= PLATEPAIRS;
+
+        if (pairCode < DIGITPAIRS){
+            text[pos] = '0' + pairCode / 10;
+            text[pos + 1] = '0' + pairCode % 10;
+        }
+        else{
+            text[pos] = 'A' + (pairCode - DIGITPAIRS) / LETTERS;
+            text[pos + 1] = 'A' + (pairCode - DIGITPAIRS) % LETTERS;
+        }
+        text[pos + 2] = pos < 6 ? '-' : '\0';
+    }
+    writeString(text);
+}
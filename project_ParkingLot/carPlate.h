@@ -0,0 +1,51 @@
+/**
+ * @file carPlate.h
+ * @brief This file contains the declaration of the licence plate related
+ * functions.
+ */
+
+// Check if the header file has already been included
+#ifndef CARPLATE_H
+#define CARPLATE_H
+
+#define TRUE 1    /**< Boolean TRUE value. */
+#define FALSE 0   /**< Boolean FALSE value. */
+#define CARPLATE 9 /**< Carplate length -> XX-XX-XX\0 */
+#define PLATEPAIRS 776 /**< The number of pairs, 100 digits and 676 letters */
+#define INVALIDPLATE 0 /**< An invalid plate, the code of 00-00-00 */
+
+/**
+ * @brief A licence plate, packed as an integer.
+ * Each pair is coded from 0 to 99 if it has two digits, and from 100 to 775
+ * if it has two uppercase letters. The plate is the three pair codes written
+ * in base PLATEPAIRS. A valid plate has a pair of letters, so its code is
+ * never below 100, and the codes 0 and 1 can be used as markers.
+ */
+typedef unsigned int plate;
+
+/**
+ * @brief Creates a plate from a string.
+ * This function validates and encodes the plate in a single pass. A valid
+ * plate has the format xx-xx-xx, where each pair has two digits or two
+ * uppercase letters. It must contain at least one pair of digits and one
+ * pair of letters.
+ * @param plateString The string to read the plate from.
+ * @return plate: The plate read, INVALIDPLATE if the plate is not valid.
+ */
+plate createCarPlate(char *plateString);
+
+/**
+ * @brief Checks if a plate is valid.
+ * @param carPlate The plate to check.
+ * @return int: TRUE if the plate is valid, FALSE otherwise.
+ */
+int isValidCarPlate(plate carPlate);
+
+/**
+ * @brief Prints a plate.
+ * This function prints the plate in the format XX-XX-XX.
+ * @param carPlate The plate to print.
+ */
+void printCarPlate(plate carPlate);
+
+#endif
@@ -0,0 +1,552 @@
+/**
+ * @file coldStore.c
+ * @brief This file contains the implementation of the cold store, where the
+ * histories of the vehicles not seen for a while are evicted as segments.
+ */
+
+// Include necessary libraries and header files
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "coldStore.h"
+#include "project.h"
+
+coldStore *openColdStore(char *path, long days, parkRegistry *allParks){
+    coldStore *store;
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+
+    if (fd < 0) return NULL;
+    unlink(path); // the file lives while it is open
+
+    store = (coldStore*) malloc(sizeof(coldStore));
+    store->fd = fd;
+    store->flushed = 0;
+    store->reserved = 0;
+    memcpy(store->buffer, COLDMAGIC, COLDMAGICSIZE); // no segment at 0
+    store->used = COLDMAGICSIZE;
+    store->failed = FALSE;
+    store->scratch = NULL;
+    store->scratchSize = 0;
+    store->days = days;
+    store->allParks = allParks;
+    store->candidates = NULL;
+    store->firstCandidate = 0;
+    store->candidateCount = 0;
+    store->candidateSize = 0;
+    store->coldCount = 0;
+    store->coldBytes = 0;
+    store->decoded.sections = NULL;
+    store->decoded.sectionSize = 0;
+    store->decoded.tickets = NULL;
+    store->decoded.ticketSize = 0;
+    return store;
+}
+
+void addColdCandidate(coldStore *store, vehicle *car){
+    coldCandidate *newCandidates;
+    long newSize, position;
+
+    if (store->candidateCount == store->candidateSize){ // the ring is full
+        newSize = store->candidateSize == 0 ? INITIALCANDIDATES :
+            store->candidateSize * 2;
+        newCandidates = (coldCandidate*) malloc(sizeof(coldCandidate) *
+            newSize);
+        for (position = 0; position < store->candidateCount; position++)
+            newCandidates[position] = store->candidates[(store->firstCandidate
+                + position) % store->candidateSize];
+
+        free(store->candidates);
+        store->candidates = newCandidates;
+        store->firstCandidate = 0;
+        store->candidateSize = newSize;
+    }
+
+    position = (store->firstCandidate + store->candidateCount) %
+        store->candidateSize;
+    store->candidates[position].car = car;
+    store->candidates[position].seen = getCarLastSeen(car);
+    store->candidateCount++;
+}
+
+/**
+ * @brief Compares two candidates for eviction by the time they were seen.
+ * @param first A pointer to the first candidate.
+ * @param second A pointer to the second candidate.
+ * @return int: Negative, 0 or positive if the first was seen before, at the
+ * same time or after the second.
+ */
+static int compareCandidates(const void *first, const void *second){
+    dateAndHour firstSeen = ((coldCandidate*) first)->seen;
+    dateAndHour secondSeen = ((coldCandidate*) second)->seen;
+
+    return (firstSeen > secondSeen) - (firstSeen < secondSeen);
+}
+
+void addRestoredCandidates(coldStore *store, hashTable *allCars){
+    unsigned int position = 0;
+    vehicle *car;
+
+    while ((car = nextInHashTable(allCars, &position)) != NULL)
+        if (!isCarParked(car)) addColdCandidate(store, car);
+
+    if (store->candidateCount > 1) // the ring starts at 0 when it is new
+        qsort(store->candidates, store->candidateCount,
+            sizeof(coldCandidate), compareCandidates);
+}
+
+/**
+ * @brief Makes the scratch of a cold store at least some bytes long.
+ * @param store A pointer to the coldStore structure.
+ * @param size The number of bytes needed.
+ */
+static void reserveScratch(coldStore *store, long size){
+    if (size <= store->scratchSize) return;
+    if (store->scratchSize == 0) store->scratchSize = COLDREAD;
+    while (store->scratchSize < size) store->scratchSize *= 2;
+    store->scratch = (unsigned char*) realloc(store->scratch,
+        store->scratchSize);
+}
+
+/**
+ * @brief Writes a number to a segment in groups of 7 bits, from the lowest.
+ * Each byte but the last has its highest bit set.
+ * @param cursor Where the number is written.
+ * @param value The number.
+ * @return unsigned char*: The byte after the number.
+ */
+static unsigned char *putVarint(unsigned char *cursor,
+    unsigned long long value){
+
+    while (value >= 0x80){
+        *cursor++ = (unsigned char) (value | 0x80);
+        value >>= 7;
+    }
+    *cursor++ = (unsigned char) value;
+    return cursor;
+}
+
+/**
+ * @brief Reads some numbers written with putVarint.
+ * @param cursor Where the numbers are read, moved past them.
+ * @param end The end of the bytes of the segment.
+ * @param values Where the numbers are stored.
+ * @param count The number of numbers.
+ * @return int: TRUE if the numbers were complete, FALSE otherwise.
+ */
+static int getVarints(unsigned char **cursor, unsigned char *end,
+    unsigned long long *values, int count){
+
+    int shift, complete;
+
+    for (; count > 0; count--, values++){
+        *values = 0;
+        complete = FALSE;
+        for (shift = 0; !complete && shift < 7 * MAXVARINT; shift += 7){
+            if (*cursor == end) return FALSE;
+            *values |= (unsigned long long) (**cursor & 0x7F) << shift;
+            complete = *(*cursor)++ < 0x80;
+        }
+        if (!complete) return FALSE;
+    }
+    return TRUE;
+}
+
+/**
+ * @brief Writes a history section to a segment.
+ * The entry of each ticket is written as the time since the previous
+ * ticket, and its exit as the time since its entry plus 1, or 0 if it is
+ * still open.
+ * @param cursor Where the section is written.
+ * @param carHist The history section.
+ * @return unsigned char*: The byte after the section.
+ */
+static unsigned char *putSection(unsigned char *cursor, carHistory *carHist){
+    dateAndHour previous = 0;
+    entryAndExit *ticket;
+    int position;
+
+    cursor = putVarint(cursor, getParkNumber(getCarHistoryPark(carHist)));
+    cursor = putVarint(cursor, getCarHistoryStoredCount(carHist));
+    cursor = putVarint(cursor, getCarHistoryLastStored(carHist));
+    cursor = putVarint(cursor, getCarHistoryTicketCount(carHist));
+
+    for (position = 0; position < getCarHistoryTicketCount(carHist);
+        position++){
+
+        ticket = getCarHistoryTicket(carHist, position);
+        cursor = putVarint(cursor, getEntry(ticket) - previous);
+        cursor = putVarint(cursor, getExit(ticket) == INVALIDTIME ? 0 :
+            getExit(ticket) - getEntry(ticket) + 1);
+        cursor = putVarint(cursor, getPayedFee(ticket));
+        previous = getExit(ticket) == INVALIDTIME ? getEntry(ticket) :
+            getExit(ticket);
+    }
+    return cursor;
+}
+
+/**
+ * @brief Writes the history of a vehicle to the scratch of a cold store, as
+ * a segment: its length, the section of the last entry plus 1, the number of
+ * sections, and the sections.
+ * @param store A pointer to the coldStore structure.
+ * @param car A pointer to the vehicle.
+ * @param size Where the number of bytes of the segment is stored.
+ * @return unsigned char*: The segment, in the scratch.
+ */
+static unsigned char *putCarSegment(coldStore *store, vehicle *car,
+    long *size){
+
+    list *history = getCarPastParked(car);
+    int ticketCount = 0, lastSection = -1, section = 0;
+    unsigned char *body, *cursor, length[MAXVARINT];
+    long lengthSize;
+    info *item;
+
+    for (item = getFirstItem(history); item != NULL;
+        item = getNextItem(item), section++){
+
+        ticketCount += getCarHistoryTicketCount(getCarHistoryInfo(item));
+        if (getCarHistoryInfo(item) == getCarLastHistory(car))
+            lastSection = section;
+    }
+    reserveScratch(store, MAXVARINT * (3 + 4 * (long) getListSize(history) +
+        3 * (long) ticketCount));
+
+    body = cursor = store->scratch + MAXVARINT; // the length goes before it
+    cursor = putVarint(cursor, lastSection + 1);
+    cursor = putVarint(cursor, getListSize(history));
+    for (item = getFirstItem(history); item != NULL; item = getNextItem(item))
+        cursor = putSection(cursor, getCarHistoryInfo(item));
+
+    lengthSize = putVarint(length, cursor - body) - length;
+    memcpy(body - lengthSize, length, lengthSize);
+    *size = lengthSize + (cursor - body);
+    return body - lengthSize;
+}
+
+/**
+ * @brief Reserves the disk for the file of a cold store up to some offset.
+ * @param store A pointer to the coldStore structure.
+ * @param end The offset.
+ * @return int: TRUE if the disk has the space, FALSE otherwise.
+ */
+static int reserveColdFile(coldStore *store, long end){
+    long size = end - store->reserved;
+
+    if (size <= 0) return TRUE;
+    if (size < COLDRESERVE) size = COLDRESERVE;
+    if (posix_fallocate(store->fd, store->reserved, size) != 0) return FALSE;
+    store->reserved += size;
+    return TRUE;
+}
+
+/**
+ * @brief Writes some bytes at the end of the file of a cold store.
+ * @param store A pointer to the coldStore structure.
+ * @param data The bytes to write.
+ * @param size The number of bytes.
+ * @return long: The number of bytes written, less than size if it failed.
+ */
+static long writeColdFile(coldStore *store, char *data, long size){
+    long done = 0;
+    ssize_t written;
+
+    while (done < size){
+        written = pwrite(store->fd, data + done, size - done, store->flushed);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) break;
+        done += written;
+        store->flushed += written;
+    }
+    return done;
+}
+
+/**
+ * @brief Writes the buffer of a cold store to its file.
+ * The bytes not written stay in the buffer, where they are still read.
+ * @param store A pointer to the coldStore structure.
+ * @return int: TRUE if the whole buffer was written, FALSE otherwise.
+ */
+static int flushColdStore(coldStore *store){
+    long done = writeColdFile(store, store->buffer, store->used);
+
+    memmove(store->buffer, store->buffer + done, store->used - done);
+    store->used -= done;
+    return store->used == 0;
+}
+
+/**
+ * @brief Adds a segment to the end of a cold store.
+ * @param store A pointer to the coldStore structure.
+ * @param segment The bytes of the segment.
+ * @param size The number of bytes.
+ * @return long: The offset of the segment, -1 if it could not be added.
+ */
+static long appendColdSegment(coldStore *store, unsigned char *segment,
+    long size){
+
+    long offset = store->flushed + store->used;
+
+    if (!reserveColdFile(store, offset + size) ||
+        (store->used + size > COLDBUFFER && !flushColdStore(store)) ||
+        (size > COLDBUFFER && writeColdFile(store, (char*) segment, size) <
+        size)){
+            store->failed = TRUE; // the disk is full, nothing more is evicted
+            return -1;
+    }
+
+    if (size <= COLDBUFFER){
+        memcpy(store->buffer + store->used, segment, size);
+        store->used += size;
+    }
+    return offset;
+}
+
+/**
+ * @brief Evicts the history of a vehicle to a cold store.
+ * @param store A pointer to the coldStore structure.
+ * @param car A pointer to the vehicle, not parked.
+ */
+static void evictColdCar(coldStore *store, vehicle *car){
+    long size, segment;
+    unsigned char *bytes = putCarSegment(store, car, &size);
+
+    if ((segment = appendColdSegment(store, bytes, size)) < 0) return;
+    evictCarHistory(car, segment);
+    store->coldCount++;
+    store->coldBytes += size;
+}
+
+void evictColdCars(coldStore *store, dateAndHour now){
+    long age = store->days * MINUTESINDAY;
+    coldCandidate candidate;
+
+    while (store->candidateCount > 0){
+        candidate = store->candidates[store->firstCandidate];
+        if ((long) (now - candidate.seen) < age) return; // the rest are newer
+
+        store->firstCandidate = (store->firstCandidate + 1) %
+            store->candidateSize;
+        store->candidateCount--;
+        if (!store->failed && !isCarCold(candidate.car) &&
+            !isCarParked(candidate.car) &&
+            getCarLastSeen(candidate.car) == candidate.seen)
+                evictColdCar(store, candidate.car);
+    }
+}
+
+/**
+ * @brief Reads some bytes of the file of a cold store.
+ * @param store A pointer to the coldStore structure.
+ * @param data Where the bytes are copied to.
+ * @param size The number of bytes.
+ * @param offset The offset of the first byte.
+ * @return long: The number of bytes read, less than size at the end of the
+ * file or if it failed.
+ */
+static long readColdFile(coldStore *store, unsigned char *data, long size,
+    long offset){
+
+    long done = 0;
+    ssize_t got;
+
+    while (done < size){
+        got = pread(store->fd, data + done, size - done, offset + done);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) break;
+        done += got;
+    }
+    return done;
+}
+
+/**
+ * @brief Gets the bytes of a segment of a cold store.
+ * A segment still in the buffer is used there, one in the file is read to
+ * the scratch, with a single read for most of them.
+ * @param store A pointer to the coldStore structure.
+ * @param segment The offset of the segment.
+ * @param end Where the end of the bytes of the segment is stored.
+ * @param size Where the number of bytes of the segment is stored.
+ * @return unsigned char*: The bytes after the length of the segment, NULL if
+ * it could not be read.
+ */
+static unsigned char *getSegmentBytes(coldStore *store, long segment,
+    unsigned char **end, long *size){
+
+    unsigned char *bytes, *cursor;
+    unsigned long long length;
+    long got, total;
+
+    if (segment >= store->flushed){ // still in the buffer
+        bytes = (unsigned char*) store->buffer + (segment - store->flushed);
+        *end = (unsigned char*) store->buffer + store->used;
+    }
+    else{
+        reserveScratch(store, COLDREAD);
+        got = readColdFile(store, store->scratch, COLDREAD, segment);
+        bytes = store->scratch;
+        *end = bytes + got;
+    }
+
+    cursor = bytes;
+    if (!getVarints(&cursor, *end, &length, 1) ||
+        length > (unsigned long long) (store->flushed + store->used))
+            return NULL;
+    total = (cursor - bytes) + length;
+
+    if (bytes + total > *end){ // the rest of a long segment
+        if (bytes != store->scratch) return NULL;
+        got = *end - bytes;
+        reserveScratch(store, total);
+        if (readColdFile(store, store->scratch + got, total - got,
+            segment + got) < total - got)
+                return NULL;
+        bytes = store->scratch;
+    }
+    *end = bytes + total;
+    *size = total;
+    return *end - length;
+}
+
+/**
+ * @brief Makes the arrays of a history read from a cold store large enough.
+ * @param history A pointer to the coldHistory structure.
+ * @param sections The number of sections needed.
+ * @param tickets The number of tickets needed.
+ */
+static void reserveColdHistory(coldHistory *history, int sections,
+    int tickets){
+
+    if (sections > history->sectionSize){
+        history->sectionSize = sections;
+        history->sections = (coldSection*) realloc(history->sections,
+            sizeof(coldSection) * sections);
+    }
+    if (tickets > history->ticketSize){
+        history->ticketSize = tickets * 2;
+        history->tickets = (entryAndExit*) realloc(history->tickets,
+            sizeof(entryAndExit) * history->ticketSize);
+    }
+}
+
+/**
+ * @brief Reads the tickets of a section from a segment.
+ * @param cursor Where the tickets are read, moved past them.
+ * @param end The end of the bytes of the segment.
+ * @param tickets Where the tickets are stored.
+ * @param count The number of tickets.
+ * @return int: TRUE if the tickets were complete, FALSE otherwise.
+ */
+static int getTickets(unsigned char **cursor, unsigned char *end,
+    entryAndExit *tickets, int count){
+
+    unsigned long long values[3];
+    dateAndHour previous = 0;
+    int position;
+
+    for (position = 0; position < count; position++){
+        if (!getVarints(cursor, end, values, 3)) return FALSE;
+        tickets[position].entry = previous + (dateAndHour) values[0];
+        tickets[position].exit = values[1] == 0 ? INVALIDTIME :
+            tickets[position].entry + (dateAndHour) (values[1] - 1);
+        tickets[position].Payedfee = (cents) values[2];
+        previous = values[1] == 0 ? tickets[position].entry :
+            tickets[position].exit;
+    }
+    return TRUE;
+}
+
+coldHistory *readColdSegment(coldStore *store, long segment){
+    coldHistory *history = &store->decoded;
+    unsigned char *end, *cursor = getSegmentBytes(store, segment, &end,
+        &history->size);
+    unsigned long long values[4];
+    int section, ticketCount = 0;
+
+    // every section takes at least 4 bytes and every ticket 3
+    if (cursor == NULL || !getVarints(&cursor, end, values, 2) ||
+        values[1] > (unsigned long long) (end - cursor) / 4 ||
+        values[0] > values[1])
+            return NULL;
+    history->lastSection = (int) values[0] - 1;
+    history->sectionCount = (int) values[1];
+    reserveColdHistory(history, history->sectionCount, 0);
+
+    for (section = 0; section < history->sectionCount; section++){
+        if (!getVarints(&cursor, end, values, 4) ||
+            values[3] > (unsigned long long) (end - cursor) / 3)
+                return NULL;
+        history->sections[section].park = (unsigned int) values[0];
+        history->sections[section].storedCount = (int) values[1];
+        history->sections[section].lastStored = (long) values[2];
+        history->sections[section].ticketCount = (int) values[3];
+
+        reserveColdHistory(history, 0, ticketCount + (int) values[3]);
+        if (!getTickets(&cursor, end, history->tickets + ticketCount,
+            (int) values[3]))
+                return NULL;
+        ticketCount += (int) values[3];
+    }
+    if (cursor != end) return NULL;
+
+    for (section = 0, ticketCount = 0; section < history->sectionCount;
+        section++){ // the array of tickets may have moved while growing
+
+        history->sections[section].tickets = history->tickets + ticketCount;
+        ticketCount += history->sections[section].ticketCount;
+    }
+    return history;
+}
+
+void loadColdCar(coldStore *store, vehicle *car){
+    coldHistory *history = readColdSegment(store, getCarColdSegment(car));
+    coldSection *section;
+    carHistory *carHist;
+    parkingLot *park;
+    int position;
+
+    reloadCarHistory(car);
+    store->coldCount--;
+    if (history == NULL){
+        fprintf(stderr, "cold store: cannot read a history.\n");
+        return;
+    }
+    store->coldBytes -= history->size;
+
+    for (position = 0; position < history->sectionCount; position++){
+        section = &history->sections[position];
+        park = searchParkByNumber(store->allParks, section->park);
+        if (park == NULL) continue; // removed while the vehicle was evicted
+
+        carHist = restoreCarHistory(park, section->tickets,
+            section->ticketCount);
+        changeCarHistoryStored(carHist, section->storedCount,
+            section->lastStored);
+        restoreCarHistorySection(car, park, carHist);
+        if (position == history->lastSection)
+            changeCarLastHistory(car, carHist);
+    }
+}
+
+int getColdStoreCount(coldStore *store){
+    if (store == NULL) return 0;
+    return store->coldCount;
+}
+
+long getColdStoreBytes(coldStore *store){
+    if (store == NULL) return 0;
+    return store->coldBytes;
+}
+
+void closeColdStore(coldStore *store){
+    if (store == NULL) return;
+    close(store->fd); // the file was already removed
+    free(store->scratch);
+    free(store->candidates);
+    free(store->decoded.sections);
+    free(store->decoded.tickets);
+    free(store);
+}
@@ -0,0 +1,173 @@
+/**
+ * @file coldStore.h
+ * @brief This header file contains the declarations of the cold store, the
+ * file where the histories of the vehicles not seen for a while are evicted.
+ */
+
+// Check if the header file has already been included
+#ifndef COLDSTORE_H
+#define COLDSTORE_H
+
+// Include header files
+#include "carPlate.h"
+#include "dateAndHour.h"
+
+#define COLDMAGIC "PKC1" /**< The first bytes of a cold store file. */
+#define COLDMAGICSIZE 4 /**< The number of bytes of the magic. */
+#define COLDSUFFIX ".cold" /**< Added to the journal path. */
+#define COLDBUFFER 65536 /**< The size of the buffer of the segments. */
+#define COLDRESERVE 16777216 /**< The bytes reserved on the disk at once. */
+#define COLDREAD 256 /**< The bytes read at once for a segment. */
+#define MAXVARINT 10 /**< The most bytes of a number in a segment. */
+#define INITIALCANDIDATES 1024 /**< The initial candidates for eviction. */
+
+// Forward declaration of structures
+typedef struct vehicle vehicle;
+typedef struct entryAndExit entryAndExit;
+typedef struct hashTable hashTable;
+typedef struct parkRegistry parkRegistry;
+
+/**
+ * @struct coldCandidate
+ * @brief A structure to represent a vehicle that may be evicted, with the
+ * time it was seen when it became a candidate. If it was seen again since,
+ * a newer candidate of it comes later.
+ */
+typedef struct coldCandidate{
+    vehicle *car; /**< The vehicle. */
+    dateAndHour seen; /**< The time it was last seen, then. */
+}coldCandidate;
+
+/**
+ * @struct coldSection
+ * @brief A structure to represent a history section read from a segment.
+ */
+typedef struct coldSection{
+    unsigned int park; /**< The number of the park of the section. */
+    int ticketCount; /**< The number of tickets in memory. */
+    int storedCount; /**< The number of tickets in the history store. */
+    long lastStored; /**< The offset of the newest stored ticket, or 0. */
+    entryAndExit *tickets; /**< The tickets in memory, by order of entry. */
+}coldSection;
+
+/**
+ * @struct coldHistory
+ * @brief A structure to represent the history of a vehicle read from a
+ * segment. Its arrays are kept and reused for the next segment read.
+ */
+typedef struct coldHistory{
+    long size; /**< The bytes of the segment. */
+    int lastSection; /**< The section of the last entry, -1 if none. */
+    int sectionCount; /**< The number of sections. */
+    coldSection *sections; /**< The sections, in the order of the history. */
+    int sectionSize; /**< The number of sections that fit in the array. */
+    entryAndExit *tickets; /**< The tickets of all the sections. */
+    int ticketSize; /**< The number of tickets that fit in the array. */
+}coldHistory;
+
+/**
+ * @struct coldStore
+ * @brief A structure to represent the cold store. Each evicted history is a
+ * segment appended to the file, its numbers written in 7 bit groups and the
+ * times as differences, so most take one or two bytes. The file is removed
+ * as soon as it is opened, it only lives while the program runs, and the
+ * disk is reserved before the segments are written, so a full disk stops
+ * the evictions instead of losing a history.
+ */
+typedef struct coldStore{
+    int fd; /**< The file descriptor of the store file. */
+    long flushed; /**< The bytes written to the file. */
+    long reserved; /**< The bytes reserved on the disk for the file. */
+    char buffer[COLDBUFFER]; /**< The bytes not yet written. */
+    int used; /**< The number of bytes in the buffer. */
+    int failed; /**< TRUE if the file could not grow, nothing is evicted. */
+    unsigned char *scratch; /**< Where segments are written and read. */
+    long scratchSize; /**< The number of bytes of the scratch. */
+    long days; /**< The days a vehicle is not seen before it is evicted. */
+    parkRegistry *allParks; /**< The parks of the sections. */
+    coldCandidate *candidates; /**< The candidates, a ring by time seen. */
+    long firstCandidate; /**< The position of the oldest candidate. */
+    long candidateCount; /**< The number of candidates. */
+    long candidateSize; /**< The number of candidates that fit in it. */
+    int coldCount; /**< The number of vehicles evicted. */
+    long coldBytes; /**< The bytes of the segments of those vehicles. */
+    coldHistory decoded; /**< The last history read from a segment. */
+}coldStore;
+
+/**
+ * @brief Creates a cold store file and removes its name.
+ * @param path The path of the store file.
+ * @param days The days a vehicle is not seen before it is evicted.
+ * @param allParks A pointer to the registry of all parks.
+ * @return coldStore*: A pointer to the created store, NULL if the file could
+ * not be created.
+ */
+coldStore *openColdStore(char *path, long days, parkRegistry *allParks);
+
+/**
+ * @brief Adds a vehicle to the candidates for eviction, with the time it was
+ * last seen, which must not be older than the one of the newest candidate.
+ * @param store A pointer to the coldStore structure.
+ * @param car A pointer to the vehicle.
+ */
+void addColdCandidate(coldStore *store, vehicle *car);
+
+/**
+ * @brief Adds the vehicles restored from a snapshot that are not parked to
+ * the candidates for eviction, by the time they were last seen.
+ * @param store A pointer to the coldStore structure, without candidates.
+ * @param allCars A pointer to the hash table of all cars.
+ */
+void addRestoredCandidates(coldStore *store, hashTable *allCars);
+
+/**
+ * @brief Evicts the vehicles not seen for the days of a cold store.
+ * The candidates older than that are taken from the oldest, and their
+ * vehicles are evicted if they were not seen since and are not parked.
+ * @param store A pointer to the coldStore structure.
+ * @param now The date and hour of the last log.
+ */
+void evictColdCars(coldStore *store, dateAndHour now);
+
+/**
+ * @brief Reads the history of a segment of a cold store.
+ * @param store A pointer to the coldStore structure.
+ * @param segment The offset of the segment.
+ * @return coldHistory*: The history, valid until the next segment is read,
+ * NULL if the segment could not be read.
+ */
+coldHistory *readColdSegment(coldStore *store, long segment);
+
+/**
+ * @brief Loads the history of an evicted vehicle back to memory.
+ * The sections are restored in the arenas of their parks, except those of
+ * parks removed since the eviction. If the segment could not be read, the
+ * vehicle is left with no history and an error is written to the standard
+ * error.
+ * @param store A pointer to the coldStore structure.
+ * @param car A pointer to the evicted vehicle.
+ */
+void loadColdCar(coldStore *store, vehicle *car);
+
+/**
+ * @brief Gets the number of vehicles evicted to a cold store.
+ * @param store A pointer to the coldStore structure, or NULL.
+ * @return int: The number of evicted vehicles.
+ */
+int getColdStoreCount(coldStore *store);
+
+/**
+ * @brief Gets the bytes of the segments of the vehicles evicted to a cold
+ * store.
+ * @param store A pointer to the coldStore structure, or NULL.
+ * @return long: The bytes of the segments.
+ */
+long getColdStoreBytes(coldStore *store);
+
+/**
+ * @brief Closes the file of a cold store and frees the coldStore structure.
+ * @param store A pointer to the coldStore structure, or NULL.
+ */
+void closeColdStore(coldStore *store);
+
+#endif
@@ -6,10 +6,9 @@
  * @date 29/03/2024
  */
 
-// Include necessary libraries and header file
-#include <stdio.h>
-#include <stdlib.h>
+// Include necessary header files
 #include "dateAndHour.h"
+#include "output.h"
 
 /**
  * @brief The number of days in each month.
@@ -18,198 +17,192 @@
  */
 static int diasMes[MESES] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
 
-date *createDate(char *dateString){
-    date *newDate = (date*) malloc(sizeof(date));
-    sscanf(dateString, "%hd-%hd-%d", &newDate->day, &newDate->month,
-        &newDate->year);
-    return newDate;
-}
+/**
+ * @brief The number of days before each month.
+ * This array contains the number of days of a year before the first day of
+ * each month, and the number of days in the year in the last position.
+ */
+static int diasAntesMes[MESES + 1] = {0, 31, 59, 90, 120, 151, 181, 212, 243,
+    273, 304, 334, 365};
 
-hours *createHours(char *hourString){
-    hours *newHours = (hours*) malloc(sizeof(hours));
-    sscanf(hourString, "%hd:%hd", &newHours->hour, &newHours->minutes);
-    return newHours;
-}
+/**
+ * @brief Reads a number from a date or hour string.
+ * This function reads the decimal digits at the start of the string and
+ * skips the separator that follows them, if it is the expected one.
+ * @param text A pointer to the string, moved past the number read.
+ * @param separator The separator expected after the number.
+ * @return int: The number read, -1 if the string doesn't start with a digit.
+ */
+static int readNumber(char **text, char separator){
+    int value = 0;
 
-dateAndHour *createDateAndHour(char *dateString, char *hourString){
-    dateAndHour *newLogTime = (dateAndHour*) malloc(sizeof(dateAndHour));
-    newLogTime -> date = createDate(dateString);
-    newLogTime -> hour = createHours(hourString);
-    return newLogTime;
-}
+    if (**text < '0' || **text > '9') return -1;
+    for (; **text >= '0' && **text <= '9'; (*text)++)
+        if (value < MAXFIELD) value = value * 10 + (**text - '0');
 
-short getDateDay(date *logDate){
-    return logDate->day;
+    if (**text == separator) (*text)++;
+    return value;
 }
 
-short getDateMonth(date *logDate){
-    return logDate->month;
+/**
+ * @brief Gets the day number of the day before the first day of a month.
+ * @param year The year of the month.
+ * @param month The month, from 1 to 12.
+ * @return date: The day number of the last day before the month.
+ */
+static date monthStart(int year, int month){
+    return year * DAYSINYEAR + diasAntesMes[month - 1];
 }
 
-int getDateYear(date *logDate){
-    return logDate->year;
-}
+/**
+ * @brief Splits a date in its day, month, and year.
+ * No month has more than 32 days, so the day of the year divided by 32 is
+ * the month or the one before it.
+ * @param logDate The date to split.
+ * @param day Where the day is stored.
+ * @param month Where the month is stored.
+ * @param year Where the year is stored.
+ */
+static void splitDate(date logDate, short *day, short *month, int *year){
+    int dayOfYear = (logDate - 1) % DAYSINYEAR, monthAux = dayOfYear / 32;
 
-short getHoursHour(hours *logHour){
-    return logHour->hour;
-}
+    if (dayOfYear >= diasAntesMes[monthAux + 1]) monthAux++;
 
-short getHoursMinutes(hours *logHour){
-    return logHour->minutes;
+    *year = (logDate - 1) / DAYSINYEAR;
+    *month = monthAux + 1;
+    *day = dayOfYear - diasAntesMes[monthAux] + 1;
 }
 
-date *getDate(dateAndHour *logTime){
-    return logTime->date;
-}
+date createDate(char *dateString){
+    int day = readNumber(&dateString, '-');
+    int month = readNumber(&dateString, '-');
+    int year = readNumber(&dateString, '\0');
 
-hours *getHours(dateAndHour *logTime){
-    return logTime->hour;
-}
+    if (year < 0 || year > MAXYEAR || month < 1 || month > MESES ||
+        day < 1 || day > diasMes[month - 1])
+            return INVALIDDATE;
 
-short getDHDay(dateAndHour *logTime){
-    return getDateDay(logTime->date);
+    return monthStart(year, month) + day;
 }
 
-short getDHMonth(dateAndHour *logTime){
-    return getDateMonth(logTime->date);
-}
+hours createHours(char *hourString){
+    int hour = readNumber(&hourString, ':');
+    int minutes = readNumber(&hourString, '\0');
+
+    if (hour < 0 || hour > 23 || minutes < 0 || minutes > 59)
+        return INVALIDHOURS;
 
-int getDHYear(dateAndHour *logTime){
-    return getDateYear(logTime->date);
+    return hour * 60 + minutes;
 }
 
-short getDHHour(dateAndHour *logTime){
-    return getHoursHour(logTime->hour);
+dateAndHour createDateAndHour(char *dateString, char *hourString){
+    date logDate = createDate(dateString);
+    hours logHours = createHours(hourString);
+
+    if (!isValidDate(logDate) || !isValidHour(logHours)) return INVALIDTIME;
+    return logDate * MINUTESINDAY + logHours;
 }
 
-short getDHMinutes(dateAndHour *logTime){
-    return getHoursMinutes(logTime->hour);
+short getDateDay(date logDate){
+    short day, month;
+    int year;
+
+    splitDate(logDate, &day, &month, &year);
+    return day;
 }
 
-void changeDate(dateAndHour *timeToChange, date *newDate){
-    timeToChange->date = newDate;
+short getDateMonth(date logDate){
+    short day, month;
+    int year;
+
+    splitDate(logDate, &day, &month, &year);
+    return month;
 }
 
-void changeHours(dateAndHour *timeToChange, hours *newHours){
-    timeToChange->hour = newHours;
+int getDateYear(date logDate){
+    return (logDate - 1) / DAYSINYEAR;
 }
 
-void copyDate(date *dateToChange, date *newDate){
-    dateToChange->day = newDate->day;
-    dateToChange->month = newDate->month;
-    dateToChange->year = newDate->year;
+int getDateDayOfYear(date logDate){
+    return (logDate - 1) % DAYSINYEAR;
 }
 
-void copyHours(hours *hourToChange, hours *newHours){
-    hourToChange->hour = newHours->hour;
-    hourToChange->minutes = newHours->minutes;
+short getHoursHour(hours logHour){
+    return logHour / 60;
 }
 
-void copyDateAndHour(dateAndHour *TimeToChange, dateAndHour *newTime){
-    copyDate(getDate(TimeToChange), newTime->date);
-    copyHours(getHours(TimeToChange), newTime->hour);
+short getHoursMinutes(hours logHour){
+    return logHour % 60;
 }
 
-int isValidDate(date* logDate){
-    if (getDateYear(logDate) < 0 || getDateMonth(logDate) < 1 ||
-        getDateMonth(logDate) > 12 || getDateDay(logDate) < 1 ||
-        getDateDay(logDate) > diasMes[getDateMonth(logDate) - 1])
-            return FALSE;
-    return TRUE;
+date getDate(dateAndHour logTime){
+    return logTime / MINUTESINDAY;
 }
 
-int isValidHour(hours *logHour){
-    if (getHoursHour(logHour) < 0 || getHoursHour(logHour) > 23 ||
-        getHoursMinutes(logHour) < 0 || getHoursMinutes(logHour) > 59)
-            return FALSE;
-    return TRUE;
+hours getHours(dateAndHour logTime){
+    return logTime % MINUTESINDAY;
 }
-int isValidDateAndHour(dateAndHour *logTime){
-    return isValidDate(getDate(logTime)) && isValidHour(getHours(logTime));
+
+int isValidDate(date logDate){
+    return logDate != INVALIDDATE;
 }
 
-int dateIsNewerThen(date *newDate, date *oldDate){
-    if (getDateYear(oldDate) < getDateYear(newDate) ||
-        (getDateYear(oldDate) == getDateYear(newDate) &&
-        getDateMonth(oldDate) < getDateMonth(newDate)) ||
-        (getDateYear(oldDate) == getDateYear(newDate) &&
-        getDateMonth(oldDate) == getDateMonth(newDate) &&
-        getDateDay(oldDate) < getDateDay(newDate)))
-            return TRUE;
-    return FALSE;
+int isValidHour(hours logHour){
+    return logHour != INVALIDHOURS;
 }
 
-int hourIsNewerOrEqualThen(hours *newHour, hours *oldHour){
-    if (getHoursHour(oldHour) < getHoursHour(newHour) ||
-        (getHoursHour(oldHour) == getHoursHour(newHour) &&
-        getHoursMinutes(oldHour) <= getHoursMinutes(newHour)))
-        return TRUE;
-    return FALSE;
+int isValidDateAndHour(dateAndHour logTime){
+    return logTime != INVALIDTIME;
 }
 
-int isNewerThen(dateAndHour *newLogTime, dateAndHour *oldLogTime){
-    if (dateIsNewerThen(getDate(newLogTime), getDate(oldLogTime)) ||
-        (isSameDate(getDate(newLogTime), getDate(oldLogTime)) &&
-        hourIsNewerOrEqualThen(getHours(newLogTime), getHours(oldLogTime))))
-            return TRUE;
-    return FALSE;
+int dateIsNewerThen(date newDate, date oldDate){
+    return newDate > oldDate;
 }
 
-int isSameDate(date *logDate1, date *logDate2){
-    return getDateYear(logDate1) == getDateYear(logDate2) &&
-        getDateMonth(logDate1) == getDateMonth(logDate2) &&
-        getDateDay(logDate1) == getDateDay(logDate2);
+int hourIsNewerOrEqualThen(hours newHour, hours oldHour){
+    return newHour >= oldHour;
 }
 
-int isSameHour(hours *logHours1, hours *logHours2){
-    return getHoursHour(logHours1) == getHoursHour(logHours2) &&
-        getHoursMinutes(logHours1) == getHoursMinutes(logHours2);
+int isNewerThen(dateAndHour newLogTime, dateAndHour oldLogTime){
+    return newLogTime >= oldLogTime;
 }
 
-int isSameDateAndHour(dateAndHour *logTime1, dateAndHour *logTime2){
-    return isSameDate(getDate(logTime1), getDate(logTime2)) &&
-        isSameHour(getHours(logTime1), getHours(logTime2));
+int isSameDate(date logDate1, date logDate2){
+    return logDate1 == logDate2;
 }
 
-void printDate(date *logDate){
-    printf("%02d-%02d-%04d", getDateDay(logDate), getDateMonth(logDate),
-        getDateYear(logDate));
+void printDate(date logDate){
+    short day, month;
+    int year;
+
+    splitDate(logDate, &day, &month, &year);
+    writePaddedNumber(day, 2);
+    writeChar('-');
+    writePaddedNumber(month, 2);
+    writeChar('-');
+    writePaddedNumber(year, 4);
 }
 
-void printHours(hours *logHours){
-    printf("%02d:%02d", getHoursHour(logHours), getHoursMinutes(logHours));
+void printHours(hours logHours){
+    writePaddedNumber(getHoursHour(logHours), 2);
+    writeChar(':');
+    writePaddedNumber(getHoursMinutes(logHours), 2);
 }
 
-void printDateAndHour(dateAndHour *logTime){
+void printDateAndHour(dateAndHour logTime){
     printDate(getDate(logTime));
-    printf(" ");
+    writeChar(' ');
     printHours(getHours(logTime));
 }
 
-int totalMinutesSinceYear(dateAndHour *logTime, int oldYear){
-    long totalMin = 0;
-    int monthAux;
-
-    totalMin += getDHMinutes(logTime) + getDHHour(logTime)* 60;
-
-    for(; oldYear < getDHYear(logTime); oldYear++)
-        totalMin += 365*24*60; // Minutes in a years
-
-    totalMin += (getDHDay(logTime) - 1)* 24 * 60; // Minutes in days
-
-    for(monthAux = getDHMonth(logTime) - 1; monthAux > 0; monthAux--)
-        totalMin += diasMes[monthAux - 1] * 24 * 60; // Minutes in months
-
-    return totalMin;
+long long differenceInMinutes(dateAndHour newLogTime, dateAndHour oldLogTime){
+    return (long long) newLogTime - oldLogTime;
 }
 
-int differenceInMinutes(dateAndHour *newLogTime, dateAndHour *oldLogTime){
-    int minutes = totalMinutesSinceYear(newLogTime, getDHYear(oldLogTime));
-    return minutes - totalMinutesSinceYear(oldLogTime, getDHYear(oldLogTime));
-}
+millicents dayPayment(int minutes, millicents initFee, millicents laterFee,
+    millicents maxFee){
 
-double dayPayment(int minutes, double initFee, double laterFee, double maxFee){
-    double money = 0;
+    millicents money = 0;
     int count;
     count = minutes / (15);
     if (minutes% 15 != 0) count++;
@@ -225,9 +218,11 @@ double dayPayment(int minutes, double initFee, double laterFee, double maxFee){
     return money;
 }
 
-double payment(int minutes, double initialFee, double laterFee, double maxFee){
-    double money = 0;
-    int count;
+millicents payment(long long minutes, millicents initialFee,
+    millicents laterFee, millicents maxFee){
+
+    millicents money = 0;
+    long long count;
     if (minutes == 0) return 0; // If  0 minutes, the fee is 0
     count = minutes / (24 * 60);
     money = count * maxFee;
@@ -236,16 +231,12 @@ double payment(int minutes, double initialFee, double laterFee, double maxFee){
     return money;
 }
 
-void freeDate(date *logDate){
-    free(logDate);
-}
-
-void freeHours(hours *logHours){
-    free(logHours);
-}
+cents roundToCents(millicents amount){
+    cents rounded = amount / MILLICENTSINCENT;
+    millicents rest = amount % MILLICENTSINCENT;
 
-void freeDateAndHour(dateAndHour *logTime){
-    freeDate(getDate(logTime));
-    freeHours(getHours(logTime));
-    free(logTime);
+    if (rest * 2 > MILLICENTSINCENT ||
+        (rest * 2 == MILLICENTSINCENT && rounded % 2 == 1))
+            rounded++;
+    return rounded;
 }
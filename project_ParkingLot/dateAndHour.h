@@ -13,319 +13,224 @@
 #define MESES 12  /**< The number of months in a year. */
 #define TRUE 1    /**< Boolean TRUE value. */
 #define FALSE 0   /**< Boolean FALSE value. */
+#define MAXFIELD 10000000 /**< Numbers above this stop growing when read. */
+#define DAYSINYEAR 365 /**< The number of days in a year, there are no leap
+    years. */
+#define MINUTESINDAY 1440 /**< The number of minutes in a day. */
+#define MINUTESINQUARTER 15 /**< The number of minutes in a billed period. */
+#define QUARTERSINDAY 96 /**< The number of billed periods in a day. */
+#define MAXYEAR 8170 /**< The last year that fits in a dateAndHour. */
+#define INVALIDDATE 0xFFFFFFFFu /**< An invalid date. */
+#define INVALIDHOURS 0xFFFFu /**< An invalid hour. */
+#define INVALIDTIME 0xFFFFFFFFu /**< An invalid or missing date and hour. */
+#define MILLICENTSINCENT 1000 /**< The thousandths of a cent in a cent. */
 
 /**
- * @struct date
- * @brief A structure to represent a date.
- * This structure represents a date with a year, month, and day.
+ * @brief An amount of money, in cents.
  */
-typedef struct date{
-    int year;      /**< The year of the date. */
-    short month;   /**< The month of the date. */
-    short day;     /**< The day of the date. */
-}date;
+typedef long long cents;
 
 /**
- * @struct hours
- * @brief A structure to represent an hour.
- * This structure represents hours with a hour and minutes.
+ * @brief A fee of a parking lot, in thousandths of a cent.
+ * Fees are kept this finely so the ones given with up to 5 decimals are
+ * exact, and only the fee of an exit is rounded to cents.
  */
-typedef struct hours{
-    short hour;    /**< The hour of the time. */
-    short minutes; /**< The minutes of the time. */
-}hours;
+typedef long long millicents;
 
 /**
- * @struct dateAndHour
- * @brief A structure to represent a date and an hour.
- * This structure represents a date and an hour with a
- * date object and an hours object.
+ * @brief A date, packed as a day number.
+ * Day 1 is 01-01-0000 and each year has 365 days. Day 0 is before any valid
+ * date, it is the date of the global time before the first log.
  */
-typedef struct dateAndHour{
-    date *date;    /**< The date object. */
-    hours *hour;   /**< The hours object. */
-}dateAndHour;
+typedef unsigned int date;
 
 /**
- * @brief Creates a date object from a string.
- * This function allocates memory for a new date object, parses the day, month,
- * and year from the input string, and returns the new date object. The input
- * string should be in the format "day-month-year".
- * @param dateString The string to parse the date from.
- * @return date*: A pointer to the newly created date object.
+ * @brief An hour, packed as the number of minutes since midnight.
  */
-date *createDate(char *dateString);
+typedef unsigned short hours;
 
 /**
- * @brief Creates an hours object from a string.
- * This function allocates memory for a new hours object, parses the hour and
- * minutes from the input string, and returns the new hours object. The input
- * string should be in the format "hour:minutes".
- * @param hourString The string to parse the time from.
- * @return hours*: A pointer to the newly created hours object.
+ * @brief A date and an hour, packed as the number of minutes since the start
+ * of day 0. The date is the quotient of the division by MINUTESINDAY and the
+ * hour is the remainder, so timestamps are compared as integers.
  */
-hours *createHours(char *hourString);
+typedef unsigned int dateAndHour;
 
 /**
- * @brief Creates a dateAndHour object from date and hour strings.
- * This function allocates memory for a new dateAndHour object, creates a date
- * object from the date string, creates an hours object from the hour string,
- * and returns the new dateAndHour object.
+ * @brief Creates a date from a string.
+ * This function parses the day, month, and year from the input string, and
+ * returns them packed as a date. The input string should be in the format
+ * "day-month-year".
  * @param dateString The string to parse the date from.
- * @param hourString The string to parse the time from.
- * @return dateAndHour*: A pointer to the newly created dateAndHour object.
- */
-dateAndHour *createDateAndHour(char *dateString, char *hourString);
-
-/**
- * @brief Gets the day from a date object.
- * @param logDate The date object.
- * @return short: The day of the date.
- */
-short getDateDay(date *logDate);
-
-/**
- * @brief Gets the month from a date object.
- * @param logDate The date object.
- * @return short: The month of the date.
- */
-short getDateMonth(date *logDate);
-
-/**
- * @brief Gets the year from a date object.
- * @param logDate The date object.
- * @return int: The year of the date.
- */
-int getDateYear(date *logDate);
-
-/**
- * @brief Gets the hour from an hours object.
- * @param logHour The hours object.
- * @return short: The hour of the time.
- */
-short getHoursHour(hours *logHour);
-
-/**
- * @brief Gets the minutes from an hours object.
- * @param logHour The hours object.
- * @return short: The minutes of the time.
- */
-short getHoursMinutes(hours *logHour);
-
-/**
- * @brief Gets the date from a dateAndHour object.
- * @param logTime The dateAndHour object.
- * @return date*: The date of the log time.
+ * @return date: The date read, INVALIDDATE if the date is not valid.
  */
-date *getDate(dateAndHour *logTime);
+date createDate(char *dateString);
 
 /**
- * @brief Gets the hours from a dateAndHour object.
- * @param logTime The dateAndHour object.
- * @return hours*: The hours of the log time.
- */
-hours *getHours(dateAndHour *logTime);
-
-/**
- * @brief Gets the day from a dateAndHour object.
- * @param logTime The dateAndHour object.
- * @return short: The day of the log time.
+ * @brief Creates an hours value from a string.
+ * This function parses the hour and minutes from the input string, and
+ * returns them packed as hours. The input string should be in the format
+ * "hour:minutes".
+ * @param hourString The string to parse the time from.
+ * @return hours: The hours read, INVALIDHOURS if the time is not valid.
  */
-short getDHDay(dateAndHour *logTime);
+hours createHours(char *hourString);
 
 /**
- * @brief Gets the month from a dateAndHour object.
- * @param logTime The dateAndHour object.
- * @return short: The month of the log time.
+ * @brief Creates a dateAndHour from date and hour strings.
+ * This function creates a date from the date string, an hours value from the
+ * hour string, and packs them in a dateAndHour.
+ * @param dateString The string to parse the date from.
+ * @param hourString The string to parse the time from.
+ * @return dateAndHour: The date and hour read, INVALIDTIME if the date or the
+ * time is not valid.
  */
-short getDHMonth(dateAndHour *logTime);
+dateAndHour createDateAndHour(char *dateString, char *hourString);
 
 /**
- * @brief Gets the year from a dateAndHour object.
- * @param logTime The dateAndHour object.
- * @return int: The year of the log time.
+ * @brief Gets the day from a date.
+ * @param logDate The date.
+ * @return short: The day of the date.
  */
-int getDHYear(dateAndHour *logTime);
+short getDateDay(date logDate);
 
 /**
- * @brief Gets the hour from a dateAndHour object.
- * @param logTime The dateAndHour object.
- * @return short: The hour of the log time.
+ * @brief Gets the month from a date.
+ * @param logDate The date.
+ * @return short: The month of the date.
  */
-short getDHHour(dateAndHour *logTime);
+short getDateMonth(date logDate);
 
 /**
- * @brief Gets the minutes from a dateAndHour object.
- * @param logTime The dateAndHour object.
- * @return short: The minutes of the log time.
+ * @brief Gets the year from a date.
+ * @param logDate The date.
+ * @return int: The year of the date.
  */
-short getDHMinutes(dateAndHour *logTime);
+int getDateYear(date logDate);
 
 /**
- * @brief Changes the date of a dateAndHour object.
- * @param timeToChange The dateAndHour object to change.
- * @param newDate The new date.
+ * @brief Gets the day of the year from a date.
+ * @param logDate The date.
+ * @return int: The day of the year, from 0 to DAYSINYEAR - 1.
  */
-void changeDate(dateAndHour *timeToChange, date *newDate);
+int getDateDayOfYear(date logDate);
 
 /**
- * @brief Changes the hours of a dateAndHour object.
- * @param timeToChange The dateAndHour object to change.
- * @param newHours The new hours.
+ * @brief Gets the hour from an hours value.
+ * @param logHour The hours value.
+ * @return short: The hour of the time.
  */
-void changeHours(dateAndHour *timeToChange, hours *newHours);
+short getHoursHour(hours logHour);
 
 /**
- * @brief Copies the values from one date object to another.
- * @param dateToChange The date object to change.
- * @param newDate The date object to copy from.
+ * @brief Gets the minutes from an hours value.
+ * @param logHour The hours value.
+ * @return short: The minutes of the time.
  */
-void copyDate(date *dateToChange, date *newDate);
+short getHoursMinutes(hours logHour);
 
 /**
- * @brief Copies the values from one hours object to another.
- * @param hourToChange The hours object to change.
- * @param newHours The hours object to copy from.
+ * @brief Gets the date from a dateAndHour.
+ * @param logTime The dateAndHour.
+ * @return date: The date of the log time.
  */
-void copyHours(hours *hourToChange, hours *newHours);
+date getDate(dateAndHour logTime);
 
 /**
- * @brief Copies the values from one dateAndHour object to another.
- * @param TimeToChange The dateAndHour object to change.
- * @param newTime The dateAndHour object to copy from.
+ * @brief Gets the hours from a dateAndHour.
+ * @param logTime The dateAndHour.
+ * @return hours: The hours of the log time.
  */
-void copyDateAndHour(dateAndHour *TimeToChange, dateAndHour *newTime);
+hours getHours(dateAndHour logTime);
 
 /**
  * @brief Checks if a date is valid.
- * This function checks if the year, month, and day of a date object are within
- * valid ranges.
  * @param logDate The date to check.
  * @return int: TRUE if the date is valid, FALSE otherwise.
  */
-int isValidDate(date *logDate);
+int isValidDate(date logDate);
 
 /**
- * @brief Checks if an hours object is valid.
- * This function checks if the hour and minutes of an hours object are within
- * valid ranges.
- * @param logHour The hours object to check.
- * @return int: TRUE if the hours object is valid, FALSE otherwise.
+ * @brief Checks if an hours value is valid.
+ * @param logHour The hours value to check.
+ * @return int: TRUE if the hours value is valid, FALSE otherwise.
  */
-int isValidHour(hours *logHour);
+int isValidHour(hours logHour);
 
 /**
- * @brief Checks if an hours object is valid.
- * This function checks if the hour and minutes of an hours object are within
- * valid ranges.
- * @param logHour The hours object to check.
- * @return int: TRUE if the hours object is valid, FALSE otherwise.
+ * @brief Checks if a dateAndHour is valid.
+ * It is also used to check if a dateAndHour is missing, like the exit of a
+ * vehicle that is still parked.
+ * @param logTime The dateAndHour to check.
+ * @return int: TRUE if the dateAndHour is valid, FALSE otherwise.
  */
-int isValidDateAndHour(dateAndHour *logHour);
+int isValidDateAndHour(dateAndHour logTime);
 
 /**
  * @brief Checks if a date is newer than another date.
- * This function compares two date objects and checks if the first date is newer
- * than the second date.
  * @param newDate The date to check if it's newer.
  * @param oldDate The date to compare with.
  * @return int: TRUE if newDate is newer than oldDate, FALSE otherwise.
  */
-int dateIsNewerThen(date *newDate, date *oldDate);
+int dateIsNewerThen(date newDate, date oldDate);
 
 /**
- * @brief Checks if an hours object is newer or equal to another hours object.
- * This function compares two hours objects and checks if the first hours object
- * is newer or equal to the second hours object.
- * @param newHour The hours object to check if it's newer or equal.
- * @param oldHour The hours object to compare with.
+ * @brief Checks if an hours value is newer or equal to another hours value.
+ * @param newHour The hours value to check if it's newer or equal.
+ * @param oldHour The hours value to compare with.
  * @return int: TRUE if newHour is newer/equal to oldHour, FALSE otherwise.
  */
-int hourIsNewerOrEqualThen(hours *newHour, hours *oldHour);
+int hourIsNewerOrEqualThen(hours newHour, hours oldHour);
 
 /**
- * @brief Checks if a dateAndHour object is newer than another dateAndHour.
- * This function compares two dateAndHour objects and checks if the first
- * dateAndHour object is newer than the second dateAndHour object.
- * @param newLogTime The dateAndHour object to check if it's newer.
- * @param oldLogTime The dateAndHour object to compare with.
- * @return int: TRUE if newLogTime is newer than oldLogTime, FALSE otherwise.
+ * @brief Checks if a dateAndHour is newer or equal to another dateAndHour.
+ * @param newLogTime The dateAndHour to check if it's newer.
+ * @param oldLogTime The dateAndHour to compare with.
+ * @return int: TRUE if newLogTime is newer or equal to oldLogTime,
+ * FALSE otherwise.
  */
-int isNewerThen(dateAndHour *newLogTime, dateAndHour *OldLogTime);
+int isNewerThen(dateAndHour newLogTime, dateAndHour oldLogTime);
 
 /**
  * @brief Checks if two dates are the same.
- * This function checks if the year, month, and day of two
- * date objects are the same.
  * @param logDate1 The first date to compare.
  * @param logDate2 The second date to compare.
  * @return int: True if the two dates are the same, FALSE otherwise.
  */
-int isSameDate(date *logDate1, date *logDate2);
-
-/**
- * @brief Checks if two hours are the same.
- * This function checks if the hour and minutes of two hours
- * objects are the same.
- * @param logHours1 The first hours object to compare.
- * @param logHours2 The second hours object to compare.
- * @return int: TRUE if the two hours objects are the same, FALSE otherwise.
- */
-int isSameHour(hours *logHours1, hours *logHours2);
-
-/**
- * @brief Checks if two dateAndHour objects are the same.
- * This function checks if the date and hours of two dateAndHour
- * objects are the same.
- * @param logTime1 The first dateAndHour object to compare.
- * @param logTime2 The second dateAndHour object to compare.
- * @return int: TRUE if the two dateAndHour are the same, FALSE otherwise.
- */
-int isSameDateAndHour(dateAndHour *logTime1, dateAndHour *logTime2);
+int isSameDate(date logDate1, date logDate2);
 
 /**
  * @brief Prints a date.
- * This function prints the day, month, and year of a date object
+ * This function prints the day, month, and year of a date
  * in the format DD-MM-YYYY.
  * @param logDate The date to print.
  */
-void printDate(date *logDate);
+void printDate(date logDate);
 
 /**
- * @brief Prints an hours object.
- * This function prints the hour and minutes of an hours object
+ * @brief Prints an hours value.
+ * This function prints the hour and minutes of an hours value
  * in the format HH:MM.
- * @param logHours The hours object to print.
+ * @param logHours The hours value to print.
  */
-void printHours(hours *logHours);
+void printHours(hours logHours);
 
 /**
- * @brief Prints a dateAndHour object.
- * This function prints the date and hours of a dateAndHour object
+ * @brief Prints a dateAndHour.
+ * This function prints the date and hours of a dateAndHour
  * in the format DD-MM-YYYY HH:MM.
- * @param logTime The dateAndHour object to print.
- */
-void printDateAndHour(dateAndHour *logTime);
-
-/**
- * @brief Calculates the total minutes since a given year.
- * This function calculates the total minutes from the start of a given year
- * to the date and hour in a dateAndHour object.
- * @param logTime The dateAndHour object.
- * @param oldYear The year to start counting from.
- * @return int: The total minutes since the start of oldYear to logTime.
+ * @param logTime The dateAndHour to print.
  */
-int totalMinutesSinceYear(dateAndHour *logTime, int oldYear);
+void printDateAndHour(dateAndHour logTime);
 
 /**
- * @brief Calculates the difference in minutes between two dateAndHour objects.
- * This function calculates the difference in minutes between the dates and
- * hours in two dateAndHour objects.
- * @param newLogTime The newer dateAndHour object.
- * @param oldLogTime The older dateAndHour object.
- * @return int: The difference in minutes between newLogTime and oldLogTime.
+ * @brief Calculates the difference in minutes between two dateAndHour values.
+ * @param newLogTime The newer dateAndHour.
+ * @param oldLogTime The older dateAndHour.
+ * @return long long: The difference in minutes between newLogTime and
+ * oldLogTime, which does not fit in an int for the longest stays.
  */
-int differenceInMinutes(dateAndHour *newLogTime, dateAndHour *oldLogTime);
+long long differenceInMinutes(dateAndHour newLogTime, dateAndHour oldLogTime);
 
 /**
  * @brief Calculates the payment for a day.
@@ -335,42 +240,31 @@ int differenceInMinutes(dateAndHour *newLogTime, dateAndHour *oldLogTime);
  * @param initFee The fee for the first 4 15-minute intervals.
  * @param laterFee The fee for each 15-minute interval after the first 4.
  * @param maxFee The maximum fee.
- * @return double: The calculated payment.
+ * @return millicents: The calculated payment.
  */
-double dayPayment(int minutes, double initFee, double laterFee, double maxFee);
+millicents dayPayment(int minutes, millicents initFee, millicents laterFee,
+    millicents maxFee);
 
 /**
  * @brief Calculates the total payment.
  * This function calculates the total payment for a given number of minutes,
- * based on an initial fee, a later fee, and a maximum fee.
+ * based on an initial fee, a later fee, and a maximum fee. The program bills
+ * with calculateFee, this is the reference bench/feeCheck.c checks it with.
  * @param minutes The number of minutes.
  * @param initialFee The fee for the first 4 15-minute intervals.
  * @param laterFee The fee for each 15-minute interval after the first 4.
  * @param maxFee The maximum fee.
- * @return double: The calculated total payment.
- */
-double payment(int minutes, double initialFee, double laterFee, double maxFee);
-
-/**
- * @brief Frees a date object.
- * This function frees the memory allocated for a date object.
- * @param logDate The date object to free.
- */
-void freeDate(date *logDate);
-
-/**
- * @brief Frees an hours object.
- * This function frees the memory allocated for an hours object.
- * @param logHours The hours object to free.
+ * @return millicents: The calculated total payment.
  */
-void freeHours(hours *logHours);
+millicents payment(long long minutes, millicents initialFee,
+    millicents laterFee, millicents maxFee);
 
 /**
- * @brief Frees a dateAndHour object.
- * This function frees the memory allocated for a dateAndHour
- * object and its components.
- * @param logTime The dateAndHour object to free.
+ * @brief Rounds an amount to the nearest cent.
+ * Half a cent rounds to the even cent, like printf rounds an exact half.
+ * @param amount The amount, not negative.
+ * @return cents: The rounded amount.
  */
-void freeDateAndHour(dateAndHour *logTime);
+cents roundToCents(millicents amount);
 
 #endif
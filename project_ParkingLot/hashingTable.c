@@ -7,36 +7,130 @@
 
 // Include necessary libraries and header file
 #include <stdlib.h>
-#include <string.h>
 #include "hashingTable.h"
 
-unsigned int hashFuncPW(char *strToHash){
-    char *letter;
-    unsigned int hashVal, tempVal;
-
-    hashVal = 0;
-    for(letter = strToHash; *letter!='\0'; letter++){
-        hashVal = (hashVal << 4) + *letter;
-        // shift the hash value 4 bits to the left.
-
-        // If the most significant 4 bits of hashVal are not 0
-        if ((tempVal = hashVal) & 0xF0000000){
-            // XOR those bits into the least significant 4 bits of hashVal.
-            hashVal ^= tempVal >>24;
-            hashVal ^= tempVal;
-            }
+/**
+ * @brief Gets the first slot to probe for a key.
+ * The key is spread with Fibonacci hashing, so the index uses all its bits
+ * and plates that only differ in their last pair don't fill nearby slots.
+ * @param key The key of the slot.
+ * @param bits The base 2 logarithm of the number of slots.
+ * @return unsigned int: The index of the slot.
+ */
+static unsigned int slotIndex(plate key, unsigned int bits){
+    return (key * 2654435769u) >> (32 - bits);
+}
+
+/**
+ * @brief Searches for a vehicle in an array of slots.
+ * @param slots The array of slots.
+ * @param size The number of slots, a power of 2.
+ * @param bits The base 2 logarithm of the size.
+ * @param key The registration of the vehicle.
+ * @return hashSlot*: The slot with the vehicle, NULL if not found.
+ */
+static hashSlot *findSlot(hashSlot *slots, unsigned int size,
+    unsigned int bits, plate key){
+
+    unsigned int index = slotIndex(key, bits);
+
+    // stop at the first empty slot, deleted slots are skipped
+    while (slots[index].car != NULL || slots[index].key != 0){
+        if (slots[index].car != NULL && slots[index].key == key)
+            return &slots[index];
+
+        index = (index + 1) & (size - 1);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Puts a vehicle in the first free slot for its key.
+ * @param slots The array of slots.
+ * @param size The number of slots, a power of 2.
+ * @param bits The base 2 logarithm of the size.
+ * @param key The registration of the vehicle.
+ * @param car The vehicle to put.
+ * @return int: TRUE if an empty slot was used, FALSE if a deleted one was.
+ */
+static int placeInSlots(hashSlot *slots, unsigned int size,
+    unsigned int bits, plate key, vehicle *car){
+
+    unsigned int index = slotIndex(key, bits);
+    int wasEmpty;
+
+    while (slots[index].car != NULL)
+        index = (index + 1) & (size - 1);
+
+    wasEmpty = slots[index].key == 0;
+    slots[index].key = key;
+    slots[index].car = car;
+    return wasEmpty;
+}
+
+/**
+ * @brief Moves some vehicles from the old array of slots to the new one.
+ * The moved slots are left deleted, so searches in the old array still go
+ * past them. When the old array has been gone through, it is freed.
+ * @param hTable The hash table.
+ * @param steps The number of old slots to go through.
+ */
+static void moveOldSlots(hashTable *hTable, unsigned int steps){
+    hashSlot *oldSlot;
+
+    for (; steps > 0 && hTable->oldTable != NULL; steps--){
+        oldSlot = &hTable->oldTable[hTable->rehashPosition];
+
+        if (oldSlot->car != NULL){
+            if (placeInSlots(hTable->table, hTable->size, hTable->bits,
+                oldSlot->key, oldSlot->car))
+                    hTable->used++;
+            oldSlot->car = NULL;
+            oldSlot->key = DELETEDKEY;
+        }
+        if (++hTable->rehashPosition == hTable->oldSize){
+            free(hTable->oldTable);
+            hTable->oldTable = NULL;
+        }
+    }
+}
+
+/**
+ * @brief Starts moving the vehicles to a new array of slots.
+ * The new array doubles the size if more than a quarter of the slots have
+ * vehicles, otherwise it has the same size and only drops the deleted slots.
+ * @param hTable The hash table.
+ */
+static void growHashTable(hashTable *hTable){
+    moveOldSlots(hTable, hTable->oldSize); // finish any previous resize
+
+    hTable->oldTable = hTable->table;
+    hTable->oldSize = hTable->size;
+    hTable->oldBits = hTable->bits;
+    hTable->rehashPosition = 0;
+
+    if ((unsigned int) getHashTableCount(hTable) * 4 > hTable->size){
+        hTable->size *= 2;
+        hTable->bits++;
     }
-    return hashVal % TABLE_SIZE;
+    hTable->table = (hashSlot*) calloc(hTable->size, sizeof(hashSlot));
+    hTable->used = 0;
 }
 
 hashTable *createHashTable(){
     hashTable *newTable = (hashTable*) malloc(sizeof(hashTable));
-    unsigned int ind;
-
-    newTable -> count = 0;
-    for(ind = 0; ind < TABLE_SIZE; ind++)
-        newTable->table[ind] = NULL;
 
+    newTable->count = 0;
+    newTable->used = 0;
+    newTable->size = INITIALTABLESIZE;
+    for (newTable->bits = 0; (1u << newTable->bits) < INITIALTABLESIZE;
+        newTable->bits++);
+
+    newTable->table = (hashSlot*) calloc(newTable->size, sizeof(hashSlot));
+    newTable->oldTable = NULL;
+    newTable->oldSize = 0;
+    newTable->oldBits = 0;
+    newTable->rehashPosition = 0;
     return newTable;
 }
 
@@ -44,73 +138,103 @@ int getHashTableCount(hashTable *hTable){
     return hTable->count;
 }
 
-info *getHashTableItem(hashTable *hTable, unsigned int index){
-    return hTable->table[index];
-}
-
 void incOrDecrHashTableCount(hashTable *hTable, int value){
     hTable->count += value;
 }
 
-void addInHashTable(hashTable *hTable, info *newInfo){
-    int index = hashFuncPW(getInfoIdentifier(newInfo));
-    info *currentItem = getHashTableItem(hTable, index);
+void addInHashTable(hashTable *hTable, vehicle *car){
+    plate key = getCarRegistration(car);
 
-    if (currentItem != NULL){ // If there is a collision
-        changeNextItem(newInfo, currentItem);
-        changePreviousItem(currentItem, newInfo);
-    }
-    hTable->table[index] = newInfo;
+    moveOldSlots(hTable, REHASHSTEP);
+    if ((unsigned int) (hTable->used + 1) * 2 > hTable->size)
+        growHashTable(hTable);
+
+    if (placeInSlots(hTable->table, hTable->size, hTable->bits, key, car))
+        hTable->used++;
     incOrDecrHashTableCount(hTable, 1);
 }
 
-info *searchInHashTable(hashTable *hTable, char *identifier){
-    int index = hashFuncPW(identifier);
-    info *currentItem = getHashTableItem(hTable, index);
+void reserveHashTable(hashTable *hTable, int count){
+    unsigned int size = hTable->size, bits = hTable->bits;
 
-    while (currentItem != NULL &&
-        strcmp(getInfoIdentifier(currentItem), identifier) != 0){
-            currentItem = getNextItem(currentItem);
+    if (hTable->count != 0 || hTable->oldTable != NULL) return;
+    while ((unsigned int) (count + 1) * 2 > size){ // as addInHashTable grows
+        size *= 2;
+        bits++;
     }
-    return currentItem;
+    if (size == hTable->size) return;
+
+    free(hTable->table);
+    hTable->table = (hashSlot*) calloc(size, sizeof(hashSlot));
+    hTable->size = size;
+    hTable->bits = bits;
+    hTable->used = 0;
 }
 
-info *popItemFromHashTable(hashTable *hTable, char *identifier){
-    info *item = searchInHashTable(hTable, identifier);
-    unsigned int index = hashFuncPW(identifier);
+/**
+ * @brief Searches for the slot of a vehicle in both arrays of slots.
+ * @param hTable The hash table.
+ * @param key The registration of the vehicle.
+ * @return hashSlot*: The slot with the vehicle, NULL if not found.
+ */
+static hashSlot *searchSlot(hashTable *hTable, plate key){
+    hashSlot *slot;
 
-    if (item == NULL) return NULL; // If the item is not in the table
-    if (getPreviousItem(item) == NULL){ // if it's the first item
-        changePreviousItem(getNextItem(item), NULL);
-        hTable->table[index] = getNextItem(item);
-    }
-    if (getNextItem(item) == NULL){ // if it's the last item
-        changeNextItem(getPreviousItem(item), NULL);
-    }
-    else{
-        changeNextItem(getPreviousItem(item), getNextItem(item));
-        changePreviousItem(getNextItem(item), getPreviousItem(item));
-    }
+    if (!isValidCarPlate(key)) return NULL;
+    slot = findSlot(hTable->table, hTable->size, hTable->bits, key);
+    if (slot == NULL && hTable->oldTable != NULL)
+        slot = findSlot(hTable->oldTable, hTable->oldSize, hTable->oldBits,
+            key);
+
+    return slot;
+}
+
+vehicle *searchInHashTable(hashTable *hTable, plate identifier){
+    hashSlot *slot = searchSlot(hTable, identifier);
+
+    if (slot == NULL) return NULL;
+    return slot->car;
+}
+
+vehicle *popItemFromHashTable(hashTable *hTable, plate identifier){
+    hashSlot *slot = searchSlot(hTable, identifier);
+    vehicle *car;
+
+    if (slot == NULL) return NULL; // If the vehicle is not in the table
+    car = slot->car;
+    slot->car = NULL;
+    slot->key = DELETEDKEY;
 
     incOrDecrHashTableCount(hTable, -1);
-    return item;
+    return car;
 }
 
-void freeHashTable(hashTable *hTable){
-    unsigned int ind = 0;
-    info *currentItem, *freeItem;
-
-    while (getHashTableCount(hTable) > 0){
-        if ((currentItem = getHashTableItem(hTable, ind)) != NULL){
-
-            while(currentItem != NULL){ // Free all items linked to the index
-                freeItem = currentItem;
-                currentItem = getNextItem(currentItem);
-                freeInfo(freeItem);
-                incOrDecrHashTableCount(hTable, -1);
-            }
-        }
-        ind++;
+vehicle *nextInHashTable(hashTable *hTable, unsigned int *position){
+    hashSlot *slot;
+
+    while (*position < hTable->size +
+        (hTable->oldTable != NULL ? hTable->oldSize : 0)){
+
+        slot = *position < hTable->size ? &hTable->table[*position] :
+            &hTable->oldTable[*position - hTable->size];
+        (*position)++;
+        if (slot->car != NULL) return slot->car;
     }
+    return NULL;
+}
+
+void freeHashTable(hashTable *hTable){
+    unsigned int ind;
+
+    for (ind = 0; ind < hTable->size; ind++)
+        if (hTable->table[ind].car != NULL)
+            freeCar(hTable->table[ind].car);
+
+    for (ind = 0; hTable->oldTable != NULL && ind < hTable->oldSize; ind++)
+        if (hTable->oldTable[ind].car != NULL)
+            freeCar(hTable->oldTable[ind].car);
+
+    free(hTable->oldTable);
+    free(hTable->table);
     free(hTable);
 }
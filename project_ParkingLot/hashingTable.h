@@ -13,35 +13,50 @@
 // Include header file
 #include "project.h"
 
-#define TABLE_SIZE 97 /**< The size of the Hash Table */
+#define INITIALTABLESIZE 1024 /**< The initial number of slots, a power of 2 */
+#define REHASHSTEP 8 /**< Old slots moved to the new table on each insertion */
+#define DELETEDKEY 1 /**< The key left in the slot of a removed vehicle, no
+    valid plate has this code. */
 
 // Forward declaration of structure
-typedef struct info info;
+typedef struct vehicle vehicle;
 
 /**
- * @struct hashTable
- * @brief A structure to represent a hash table. This structure represents a
- * hash table with its count of items and an array of pointers to the items.
+ * @struct hashSlot
+ * @brief A structure to represent a slot of the hash table.
+ * A slot with a vehicle is in use. A slot without a vehicle is empty if its
+ * key is 0, or deleted if its key is DELETEDKEY, searches don't stop on
+ * deleted slots. The key is the plate itself, so searches compare integers.
  */
-typedef struct hashTable {
-    int count; /**< The count of items in the hash table. */
-    struct info *table[TABLE_SIZE]; /**< An array of pointers to
-        the items in the hash table. */
-} hashTable;
+typedef struct hashSlot{
+    plate key; /**< The vehicle's registration. */
+    vehicle *car; /**< The vehicle stored in the slot. */
+}hashSlot;
 
 /**
- * @brief Hash function based on Peter Weinberger's method.
- * This function calculates the hash value of a string using Peter Weinberger's
- * method. It's used to determine the index for a string in the hash table.
- * @param strToHash The string to hash.
- * @return unsigned int: The hash value.
+ * @struct hashTable
+ * @brief A structure to represent a hash table. This structure represents an
+ * open addressing hash table, with linear probing, that grows as vehicles are
+ * added. When it grows, the vehicles of the old slots array are moved to the
+ * new one a few at a time on each insertion, so no insertion pays for the
+ * whole resize. Until then, searches look in both arrays.
  */
-unsigned int hashFuncPW(char *strToHash);
+typedef struct hashTable {
+    int count; /**< The count of vehicles in the hash table. */
+    int used; /**< The count of slots in use or deleted in the table. */
+    unsigned int size; /**< The number of slots in the table. */
+    unsigned int bits; /**< The base 2 logarithm of the size. */
+    hashSlot *table; /**< The array of slots. */
+    hashSlot *oldTable; /**< The array being emptied, NULL if there is none */
+    unsigned int oldSize; /**< The number of slots in the old array. */
+    unsigned int oldBits; /**< The base 2 logarithm of the old size. */
+    unsigned int rehashPosition; /**< The next old slot to be moved. */
+} hashTable;
 
 /**
  * @brief Creates a new hash table.
- * This function creates a new hash table and initializes all its
- * entries to NULL. It also sets the count of items in the table to 0.
+ * This function creates a new hash table with INITIALTABLESIZE empty slots.
+ * It also sets the count of items in the table to 0.
  * @return hashTable*: A pointer to the created hash table.
  */
 hashTable *createHashTable();
@@ -54,49 +69,63 @@ hashTable *createHashTable();
 int getHashTableCount(hashTable *hTable);
 
 /**
- * @brief Gets the item at a specific index in the hash table.
+ * @brief Increases or decreases the count of items in the hash table.
  * @param hTable The hash table.
- * @param index The index of the item.
- * @return info*: The item at the specified index.
+ * @param value The value to increase or decrease the count by.
  */
-info *getHashTableItem(hashTable *hTable, unsigned int index);
+void incOrDecrHashTableCount(hashTable *hTable, int value);
 
 /**
- * @brief Increases or decreases the count of items in the hash table.
+ * @brief Adds a vehicle to the hash table.
+ * The vehicle must not be in the table. If the table is too full, it starts
+ * moving the vehicles to a larger table.
  * @param hTable The hash table.
- * @param value The value to increase or decrease the count by.
+ * @param car The vehicle to add.
  */
-void incOrDecrHashTableCount(hashTable *hTable, int value);
+void addInHashTable(hashTable *hTable, vehicle *car);
+
+/**
+ * @brief Makes an empty hash table large enough for some vehicles.
+ * Vehicles added in the order of the slots of another table all start
+ * probing near each other in a smaller table, so a table is sized for all of
+ * them before they are added, like when a snapshot is restored.
+ * @param hTable The empty hash table.
+ * @param count The number of vehicles that will be added.
+ */
+void reserveHashTable(hashTable *hTable, int count);
 
 /**
- * @brief Adds an item to the hash table.
+ * @brief Searches for a vehicle in the hash table.
  * @param hTable The hash table.
- * @param newInfo The item to add.
+ * @param identifier The registration of the vehicle to search for.
+ * @return vehicle*: The vehicle found or NULL if not found.
  */
-void addInHashTable(hashTable *hTable, info *newInfo);
+vehicle *searchInHashTable(hashTable *hTable, plate identifier);
 
 /**
- * @brief Searches for an item in the hash table.
+ * @brief Gets the next vehicle of the hash table, in the order of its slots.
+ * The vehicles of the slots array being emptied come after the others.
  * @param hTable The hash table.
- * @param identifier The identifier of the item to search for.
- * @return info*: The item found or NULL if not found.
+ * @param position The position of the next slot, 0 for the first vehicle,
+ * moved past the vehicle found.
+ * @return vehicle*: The vehicle found or NULL if there are no more.
  */
-info *searchInHashTable(hashTable *hTable, char *identifier);
+vehicle *nextInHashTable(hashTable *hTable, unsigned int *position);
 
 /**
- * @brief Pops an item from the hash table.
- * This function pops an item from the hash table and adjusts the links
- * between items accordingly. If the item is not found, it returns NULL.
+ * @brief Pops a vehicle from the hash table.
+ * This function removes a vehicle from the hash table, leaving its slot
+ * deleted. If the vehicle is not found, it returns NULL.
  * @param hTable The hash table.
- * @param identifier The identifier of the item to pop.
- * @return info*: The poped item or NULL if not found.
+ * @param identifier The registration of the vehicle to pop.
+ * @return vehicle*: The poped vehicle or NULL if not found.
  */
-info *popItemFromHashTable(hashTable *hTable, char *identifier);
+vehicle *popItemFromHashTable(hashTable *hTable, plate identifier);
 
 /**
  * @brief Frees the hash table.
  * This function frees the memory allocated for the hash table
- * and all its items.
+ * and all its vehicles.
  * @param hTable The hash table.
  */
 void freeHashTable(hashTable *hTable);
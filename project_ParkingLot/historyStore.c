@@ -0,0 +1,189 @@
+/**
+ * @file historyStore.c
+ * @brief This file contains the implementation of the store of the completed
+ * entries and exits of the vehicles, a file mapped in memory.
+ */
+
+// Include necessary libraries and header files
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "historyStore.h"
+#include "project.h"
+
+/**
+ * @brief Gets the header of a history store, at the start of its mapping.
+ * @param store A pointer to the historyStore structure.
+ * @return historyHeader*: The header in the mapping.
+ */
+static historyHeader *getHistoryHeader(historyStore *store){
+    return (historyHeader*) store->mapping;
+}
+
+/**
+ * @brief Checks if the used bytes of a history store file are valid.
+ * @param used The bytes of the header and the records.
+ * @param size The size of the file.
+ * @return int: TRUE if they fit in the file and end after a record, FALSE
+ * otherwise.
+ */
+static int isValidHistoryEnd(long used, long size){
+    return used >= (long) sizeof(historyHeader) && used <= size &&
+        (used - sizeof(historyHeader)) % sizeof(historyRecord) == 0;
+}
+
+historyStore *openHistoryStore(char *path){
+    historyStore *store;
+    historyHeader *header;
+    struct stat fileStat;
+    void *mapping;
+    long size;
+    int fd = open(path, O_RDWR | O_CREAT, 0644), reserved;
+
+    if (fd < 0) return NULL;
+    if (fstat(fd, &fileStat) != 0 || (fileStat.st_size != 0 &&
+        fileStat.st_size < (off_t) sizeof(historyHeader))){
+            close(fd);
+            return NULL;
+    }
+
+    size = fileStat.st_size == 0 ? HISTORYINITIALSIZE : fileStat.st_size;
+    // the spare bytes of the file may have no blocks yet, a new one needs them
+    reserved = posix_fallocate(fd, 0, size) == 0;
+    if (fileStat.st_size == 0 && (!reserved || !syncParentDirectory(path))){
+        close(fd);
+        return NULL;
+    }
+    mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED){
+        close(fd);
+        return NULL;
+    }
+
+    header = (historyHeader*) mapping;
+    if (fileStat.st_size == 0){ // a new store, the rest of it is zeros
+        memcpy(header->magic, HISTORYMAGIC, HISTORYMAGICSIZE);
+        header->used = sizeof(historyHeader);
+    }
+    else if (memcmp(header->magic, HISTORYMAGIC, HISTORYMAGICSIZE) != 0 ||
+        !isValidHistoryEnd(header->used, size)){
+            munmap(mapping, size);
+            close(fd);
+            return NULL;
+    }
+
+    store = (historyStore*) malloc(sizeof(historyStore));
+    store->fd = fd;
+    store->mapping = (char*) mapping;
+    store->size = size;
+    store->next = sizeof(historyHeader); // the replay starts from the first
+    store->failed = !reserved; // only the records written are read
+    return store;
+}
+
+/**
+ * @brief Makes the file of a history store at least some bytes long.
+ * The file is doubled and mapped again, so the records move in memory and
+ * only their offsets stay the same. The blocks of the new bytes are reserved
+ * before they are mapped, so a full disk fails here instead of on a write to
+ * the mapping.
+ * @param store A pointer to the historyStore structure.
+ * @param needed The number of bytes needed.
+ * @return int: TRUE if the file grew, FALSE otherwise.
+ */
+static int growHistoryStore(historyStore *store, long needed){
+    long newSize = store->size < HISTORYINITIALSIZE ? HISTORYINITIALSIZE :
+        store->size;
+    void *mapping;
+
+    while (newSize < needed) newSize *= 2;
+    if (posix_fallocate(store->fd, store->size, newSize - store->size) != 0)
+        return FALSE;
+    mapping = mmap(NULL, newSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+        store->fd, 0);
+    if (mapping == MAP_FAILED) return FALSE;
+
+    munmap(store->mapping, store->size);
+    store->mapping = (char*) mapping;
+    store->size = newSize;
+    return TRUE;
+}
+
+/**
+ * @brief Checks if two records of a history store are the same.
+ * @param first A pointer to the first record.
+ * @param second A pointer to the second record.
+ * @return int: TRUE if all their fields are equal, FALSE otherwise.
+ */
+static int isSameHistoryRecord(historyRecord *first, historyRecord *second){
+    return first->previous == second->previous &&
+        first->journalOffset == second->journalOffset &&
+        first->registration == second->registration &&
+        first->park == second->park && first->entry == second->entry &&
+        first->exit == second->exit && first->fee == second->fee;
+}
+
+long addHistoryRecord(historyStore *store, historyRecord *record){
+    long offset = store->next, end = offset + sizeof(historyRecord);
+
+    if (offset < getHistoryHeader(store)->used){ // replayed over the file
+        if (isSameHistoryRecord(getHistoryRecord(store, offset), record)){
+            store->next = end;
+            return offset;
+        }
+        getHistoryHeader(store)->used = offset; // not kept in the journal
+    }
+
+    if (store->failed) return -1;
+    if (end > store->size && !growHistoryStore(store, end)){
+        store->failed = TRUE; // the disk is full, the rest stays in memory
+        return -1;
+    }
+    memcpy(store->mapping + offset, record, sizeof(historyRecord));
+    store->next = end;
+    getHistoryHeader(store)->used = end;
+    return offset;
+}
+
+historyRecord *getHistoryRecord(historyStore *store, long offset){
+    return (historyRecord*) (store->mapping + offset);
+}
+
+int isHistoryRecordOffset(historyStore *store, long offset){
+    return offset >= (long) sizeof(historyHeader) &&
+        offset + (long) sizeof(historyRecord) <= store->next &&
+        (offset - sizeof(historyHeader)) % sizeof(historyRecord) == 0;
+}
+
+long getHistoryStoreNext(historyStore *store){
+    return store->next;
+}
+
+int changeHistoryStoreNext(historyStore *store, long next){
+    if (!isValidHistoryEnd(next, getHistoryHeader(store)->used))
+        return FALSE;
+    store->next = next;
+    return TRUE;
+}
+
+void endHistoryReplay(historyStore *store){
+    getHistoryHeader(store)->used = store->next;
+}
+
+int syncHistoryStore(historyStore *store){
+    return msync(store->mapping, store->size, MS_SYNC) == 0;
+}
+
+void closeHistoryStore(historyStore *store){
+    long used;
+
+    if (store == NULL) return;
+    used = getHistoryHeader(store)->used;
+    munmap(store->mapping, store->size);
+    ftruncate(store->fd, used); // if it fails, the spare bytes are kept
+    close(store->fd);
+    free(store);
+}
@@ -0,0 +1,141 @@
+/**
+ * @file historyStore.h
+ * @brief This header file contains the declarations of the store of the
+ * completed entries and exits of the vehicles, a file mapped in memory.
+ */
+
+// Check if the header file has already been included
+#ifndef HISTORYSTORE_H
+#define HISTORYSTORE_H
+
+// Include necessary header files
+#include "carPlate.h"
+#include "dateAndHour.h"
+
+#define HISTORYMAGIC "PKH1" /**< The first bytes of a history store file. */
+#define HISTORYMAGICSIZE 4 /**< The number of bytes of the magic. */
+#define HISTORYSUFFIX ".hist" /**< Added to the journal path. */
+#define HISTORYINITIALSIZE 1048576 /**< The initial size of the file. */
+
+/**
+ * @struct historyHeader
+ * @brief A structure to represent the start of a history store file.
+ */
+typedef struct historyHeader{
+    char magic[8]; /**< HISTORYMAGIC, and zeros. */
+    long used; /**< The number of bytes of the header and the records. */
+}historyHeader;
+
+/**
+ * @struct historyRecord
+ * @brief A structure to represent a completed entry and exit of a vehicle in
+ * a park, in the store. The records of the same history section are linked
+ * by their offsets in the file, from the newest to the oldest, so the links
+ * stay valid wherever the file is mapped.
+ */
+typedef struct historyRecord{
+    long previous; /**< The offset of the previous record of the section, 0
+        if it is the first. */
+    long journalOffset; /**< The offset of the exit in the journal. */
+    plate registration; /**< The plate of the vehicle. */
+    unsigned int park; /**< The number of the park. */
+    dateAndHour entry; /**< The entry time of the vehicle. */
+    dateAndHour exit; /**< The exit time of the vehicle. */
+    cents fee; /**< The fee paid by the vehicle. */
+}historyRecord;
+
+/**
+ * @struct historyStore
+ * @brief A structure to represent the store of completed entries and exits.
+ * The file only grows, its records are never changed, and the pages not used
+ * for a while can be dropped by the system and read again when needed. While
+ * the journal is replayed, the records already in the file are checked
+ * against the replayed exits instead of being written again. Every byte of
+ * the mapping has its blocks reserved on the disk, so writing a record never
+ * runs out of space.
+ */
+typedef struct historyStore{
+    int fd; /**< The file descriptor of the store file. */
+    char *mapping; /**< The mapping of the whole file. */
+    long size; /**< The size of the file and of the mapping. */
+    long next; /**< The offset of the next record added. */
+    int failed; /**< TRUE if the file could not grow or its blocks could not
+        be reserved, nothing more is added. */
+}historyStore;
+
+/**
+ * @brief Opens a history store file, or creates it if it does not exist.
+ * @param path The path of the store file.
+ * @return historyStore*: A pointer to the created store, NULL if the file
+ * could not be opened or is not a history store.
+ */
+historyStore *openHistoryStore(char *path);
+
+/**
+ * @brief Adds a completed entry and exit to a history store.
+ * If the record at the next offset is the same, as when the journal is
+ * replayed over a store already written, it is used as it is. Otherwise the
+ * records from there on are dropped and the new one is written.
+ * @param store A pointer to the historyStore structure.
+ * @param record The record to add.
+ * @return long: The offset of the record, -1 if the file could not grow.
+ */
+long addHistoryRecord(historyStore *store, historyRecord *record);
+
+/**
+ * @brief Gets a record of a history store.
+ * @param store A pointer to the historyStore structure.
+ * @param offset The offset of the record.
+ * @return historyRecord*: The record in the mapping, valid until the next
+ * record is added.
+ */
+historyRecord *getHistoryRecord(historyStore *store, long offset);
+
+/**
+ * @brief Checks if an offset is the offset of a record in a history store.
+ * @param store A pointer to the historyStore structure.
+ * @param offset The offset.
+ * @return int: TRUE if a record starts there, before the next one added,
+ * FALSE otherwise.
+ */
+int isHistoryRecordOffset(historyStore *store, long offset);
+
+/**
+ * @brief Gets the offset of the next record added to a history store.
+ * @param store A pointer to the historyStore structure.
+ * @return long: The offset after the last record.
+ */
+long getHistoryStoreNext(historyStore *store);
+
+/**
+ * @brief Changes the offset of the next record added to a history store.
+ * It is used to go on from the records covered by a snapshot.
+ * @param store A pointer to the historyStore structure.
+ * @param next The new offset, after a record in the file.
+ * @return int: TRUE if the file has records up to there, FALSE otherwise.
+ */
+int changeHistoryStoreNext(historyStore *store, long next);
+
+/**
+ * @brief Drops the records of a history store after the next offset.
+ * It is called after a replay, to drop the records of exits that were not
+ * kept in the journal.
+ * @param store A pointer to the historyStore structure.
+ */
+void endHistoryReplay(historyStore *store);
+
+/**
+ * @brief Writes the changed pages of a history store to the disk.
+ * @param store A pointer to the historyStore structure.
+ * @return int: TRUE if the pages were written, FALSE otherwise.
+ */
+int syncHistoryStore(historyStore *store);
+
+/**
+ * @brief Cuts the file of a history store after its records, unmaps and
+ * closes it, and frees the historyStore structure.
+ * @param store A pointer to the historyStore structure.
+ */
+void closeHistoryStore(historyStore *store);
+
+#endif
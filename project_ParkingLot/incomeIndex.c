@@ -0,0 +1,84 @@
+/**
+ * @file incomeIndex.c
+ * @brief This file contains the implementation of the income by day of a
+ * park.
+ */
+
+// Include necessary library and header file
+#include <stdlib.h>
+#include "incomeIndex.h"
+
+incomeIndex *createIncomeIndex(){
+    incomeIndex *index = (incomeIndex*) malloc(sizeof(incomeIndex));
+
+    index->size = INITIALINCOMEDAYS;
+    index->count = 0;
+    index->days = (date*) malloc(sizeof(date) * index->size);
+    index->totals = (cents*) malloc(sizeof(cents) * index->size);
+    return index;
+}
+
+void addToIncomeIndex(incomeIndex *index, date logDate, cents fee){
+    if (index->count > 0 && isSameDate(index->days[index->count - 1],
+        logDate)){
+            index->totals[index->count - 1] += fee;
+            return;
+    }
+
+    if (index->count == index->size){ // the arrays are full
+        index->size *= 2;
+        index->days = (date*) realloc(index->days,
+            sizeof(date) * index->size);
+        index->totals = (cents*) realloc(index->totals,
+            sizeof(cents) * index->size);
+    }
+    index->days[index->count] = logDate;
+    index->totals[index->count] = getIncomeTotal(index) + fee;
+    index->count++;
+}
+
+cents getIncomeTotal(incomeIndex *index){
+    if (index->count == 0) return 0;
+    return index->totals[index->count - 1];
+}
+
+int getIncomeDayCount(incomeIndex *index){
+    return index->count;
+}
+
+date getIncomeDay(incomeIndex *index, int position){
+    return index->days[position];
+}
+
+cents getIncomeOfDay(incomeIndex *index, int position){
+    if (position == 0) return index->totals[0];
+    return index->totals[position] - index->totals[position - 1];
+}
+
+/**
+ * @brief Gets the income of the days before a date.
+ * @param index A pointer to the incomeIndex structure.
+ * @param logDate The date.
+ * @return cents: The income of all the days earlier than the date.
+ */
+static cents incomeBefore(incomeIndex *index, date logDate){
+    int low = 0, high = index->count, middle;
+
+    while (low < high){ // find the first day not earlier than the date
+        middle = low + (high - low) / 2;
+        if (dateIsNewerThen(logDate, index->days[middle])) low = middle + 1;
+        else high = middle;
+    }
+    if (low == 0) return 0;
+    return index->totals[low - 1];
+}
+
+cents getIncomeInRange(incomeIndex *index, date firstDate, date lastDate){
+    return incomeBefore(index, lastDate + 1) - incomeBefore(index, firstDate);
+}
+
+void freeIncomeIndex(incomeIndex *index){
+    free(index->days);
+    free(index->totals);
+    free(index);
+}
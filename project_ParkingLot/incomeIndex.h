@@ -0,0 +1,93 @@
+/**
+ * @file incomeIndex.h
+ * @brief This header file contains the declarations of the incomeIndex
+ * structure and related functions.
+ */
+
+// Check if the header file has already been included
+#ifndef INCOMEINDEX_H
+#define INCOMEINDEX_H
+
+// Include header file
+#include "project.h"
+
+#define INITIALINCOMEDAYS 16 /**< The initial number of days of an index. */
+
+/**
+ * @struct incomeIndex
+ * @brief A structure to represent the income of a park by day. This structure
+ * keeps the days with exits in chronological order and, for each of them,
+ * the income of that day and of all the days before it, so the income of a
+ * range of days is the difference of two totals.
+ */
+typedef struct incomeIndex{
+    date *days; /**< The days with exits, in chronological order. */
+    cents *totals; /**< The income up to the end of each day. */
+    int count; /**< The number of days with exits. */
+    int size; /**< The number of days that fit in the arrays. */
+}incomeIndex;
+
+/**
+ * @brief Creates a new incomeIndex structure without days.
+ * @return incomeIndex*: A pointer to the created incomeIndex structure.
+ */
+incomeIndex *createIncomeIndex();
+
+/**
+ * @brief Adds the fee of an exit to an index.
+ * The date must not be earlier than the last date of the index, as exits
+ * are registered in chronological order.
+ * @param index A pointer to the incomeIndex structure.
+ * @param logDate The date of the exit.
+ * @param fee The fee paid.
+ */
+void addToIncomeIndex(incomeIndex *index, date logDate, cents fee);
+
+/**
+ * @brief Gets the income of all the days of an index.
+ * @param index A pointer to the incomeIndex structure.
+ * @return cents: The total income.
+ */
+cents getIncomeTotal(incomeIndex *index);
+
+/**
+ * @brief Gets the number of days with exits of an index.
+ * @param index A pointer to the incomeIndex structure.
+ * @return int: The number of days.
+ */
+int getIncomeDayCount(incomeIndex *index);
+
+/**
+ * @brief Gets a day with exits of an index.
+ * @param index A pointer to the incomeIndex structure.
+ * @param position The position of the day, from 0, in chronological order.
+ * @return date: The date of the day.
+ */
+date getIncomeDay(incomeIndex *index, int position);
+
+/**
+ * @brief Gets the income of a day with exits of an index.
+ * @param index A pointer to the incomeIndex structure.
+ * @param position The position of the day, from 0, in chronological order.
+ * @return cents: The income of that day.
+ */
+cents getIncomeOfDay(incomeIndex *index, int position);
+
+/**
+ * @brief Gets the income of a range of days.
+ * The days of the range are found by binary search, so the income is found
+ * in logarithmic time.
+ * @param index A pointer to the incomeIndex structure.
+ * @param firstDate The first day of the range.
+ * @param lastDate The last day of the range.
+ * @return cents: The income from firstDate to lastDate, both included.
+ */
+cents getIncomeInRange(incomeIndex *index, date firstDate, date lastDate);
+
+/**
+ * @brief Frees the memory allocated for an incomeIndex structure.
+ * @param index A pointer to the incomeIndex structure.
+ */
+void freeIncomeIndex(incomeIndex *index);
+
+#endif
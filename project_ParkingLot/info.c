@@ -9,25 +9,18 @@
 #include <stdlib.h>
 #include "info.h"
 
+static nodePool infoPool = NODEPOOL(info); /**< The pool of info nodes. */
+
 info *createInfo(void *item, unsigned char type){
-    info *newInfo = (info*) malloc(sizeof(info));
+    info *newInfo = (info*) allocateNode(&infoPool);
 
     newInfo->type = type;
     if (type == ISVEHICLE){
         newInfo->details = (vehicle*) item;
     }
-    else if (type == ISPARKEDCARS){
-        newInfo->details = (parkedCars*) item;
-    }
     else if (type == ISCARHISTORY){
         newInfo->details = (carHistory*) item;
     }
-    else if(type == ISEXITVEHICLE){
-        newInfo->details= (exitVehicle*) item;
-    }
-    else if(type == ISENTRYANDEXIT){
-        newInfo->details = (entryAndExit*) item;
-    }
     else if (type == ISPARKINGLOT){
         newInfo->details = (parkingLot*) item;
     }
@@ -49,13 +42,7 @@ parkingLot *getParkInfo(info *item){
 
 vehicle *getCarInfo(info *item){
     if (item == NULL) return NULL;
-    if (getInfoType(item) == ISVEHICLE) return (vehicle*) item->details;
-    return getExitVehicleCar((exitVehicle*) item->details);
-}
-
-parkedCars *getParkedCarsInfo(info *item){
-    if (item == NULL) return NULL;
-    return (parkedCars*) item->details;
+    return (vehicle*) item->details;
 }
 
 carHistory *getCarHistoryInfo(info *item){
@@ -63,16 +50,6 @@ carHistory *getCarHistoryInfo(info *item){
     return (carHistory*) item->details;
 }
 
-entryAndExit *getEntryAndExitInfo(info *item){
-    if (item == NULL) return NULL;
-    return (entryAndExit*) item->details;
-}
-
-exitVehicle *getExitVehicleInfo(info *item){
-    if (item == NULL) return NULL;
-    return (exitVehicle*) item->details;
-}
-
 info *getNextItem(info *item){
     return item->nextItem;
 }
@@ -82,10 +59,7 @@ info *getPreviousItem(info *item){
 }
 
 char *getInfoIdentifier(info *item){
-    if (getInfoType(item) == ISVEHICLE)
-        return getCarRegistration(getCarInfo(item));
-
-    else if (getInfoType(item) == ISPARKINGLOT)
+    if (getInfoType(item) == ISPARKINGLOT)
         return getParkName(getParkInfo(item));
 
     else
@@ -110,17 +84,13 @@ void freeInfo(info *itemInfo){
     else if (infoType == ISPARKINGLOT)
         freePark(getParkInfo(itemInfo));
 
-    else if (infoType == ISCARHISTORY)
-        freeCarHistory(getCarHistoryInfo(itemInfo));
-
-    else if (infoType == ISPARKEDCARS)
-        freeParkedCars(getParkedCarsInfo(itemInfo));
-
-    else if(infoType == ISENTRYANDEXIT)
-        freeEntryAndExit(getEntryAndExitInfo(itemInfo));
+    freeInfoItem(itemInfo);
+}
 
-    else if(infoType == ISEXITVEHICLE)
-        freeExitVehicle(getExitVehicleInfo(itemInfo));
+void freeInfoItem(info *itemInfo){
+    releaseNode(&infoPool, itemInfo);
+}
 
-    free(itemInfo);
+nodePool *getInfoPool(){
+    return &infoPool;
 }
@@ -16,18 +16,12 @@
 // Forward declaration of structures
 typedef struct parkingLot parkingLot;
 typedef struct vehicle vehicle;
-typedef struct parkedCars parkedCars;
 typedef struct carHistory carHistory;
-typedef struct entryAndExit entryAndExit;
-typedef struct exitVehicle exitVehicle;
 
 // Define constants to identify item types
 #define ISPARKINGLOT 0
 #define ISVEHICLE 1
-#define ISPARKEDCARS 2
-#define ISCARHISTORY 3
-#define ISENTRYANDEXIT 4
-#define ISEXITVEHICLE 5
+#define ISCARHISTORY 2
 
 /**
  * @struct info
@@ -44,9 +38,9 @@ typedef struct info{
 
 /**
  * @brief Creates a new info structure.
- * This function allocates memory for a new info structure and initializes it
- * with the given parameters. It sets the type of the info and assigns the
- * details pointer to the appropriate type based on the given type.
+ * This function takes a new info structure from the pool of info nodes and
+ * initializes it with the given parameters. It sets the type of the info and
+ * assigns the details pointer to the appropriate type based on the given type.
  * It also initializes the nextItem and previousItem pointers to NULL.
  * @param item A pointer to the item to be stored in the info structure.
  * @param type The type of the item.
@@ -77,14 +71,6 @@ parkingLot* getParkInfo(info *item);
  */
 vehicle* getCarInfo(info *item);
 
-/**
- * @brief Retrieves the parked cars information from an info item.
- * @param item A pointer to the info item.
- * @return parkedCars*: A pointer to the parked cars information if it exists,
- * NULL otherwise.
- */
-parkedCars* getParkedCarsInfo(info *item);
-
 /**
  * @brief Retrieves the car history information from an info item.
  * @param item A pointer to the info item.
@@ -93,22 +79,6 @@ parkedCars* getParkedCarsInfo(info *item);
  */
 carHistory* getCarHistoryInfo(info *item);
 
-/**
- * @brief Retrieves the entry and exit information from an info item.
- * @param item A pointer to the info item.
- * @return entryAndExit*: A pointer to the entry and exit information if it
- * exists, NULL otherwise.
- */
-entryAndExit* getEntryAndExitInfo(info *item);
-
-/**
- * @brief Retrieves the exit vehicle information from an info item.
- * @param item A pointer to the info item.
- * @return exitVehicle*: A pointer to the exit vehicle information if it exists,
- * NULL otherwise.
- */
-exitVehicle* getExitVehicleInfo(info *item);
-
 /**
  * @brief Retrieves the next item from an info item.
  * @param item A pointer to the info item.
@@ -127,9 +97,9 @@ info *getPreviousItem(info *item);
 /**
  * @brief Retrieves the identifier of an info item based on its type.
  * This function checks the type of the info item and returns the corresponding
- * identifier. If the info item is a vehicle, it returns the car registration.
- * If the info item is a parking lot, it returns the park name.
- * Otherwise, it returns the car history name (park name).
+ * identifier. If the info item is a parking lot, it returns the park name.
+ * Otherwise, it returns the car history name (park name). Vehicles are
+ * identified by their plate.
  * @param item A pointer to the info item.
  * @return char*: The identifier of the info item if it exists, NULL otherwise.
  */
@@ -151,11 +121,25 @@ void changePreviousItem(info *item, info *newPreviousItem);
 
 /**
  * @brief Frees the memory for the details of an info item based on its type.
- * The function identifies the type of the info item (vehicle, parking lot,
- * car history, parked cars list) and frees the memory allocated for the
- * corresponding details. Then calls the specific free function.
+ * The function identifies the type of the info item (vehicle or parking lot)
+ * and frees the memory allocated for the corresponding details. Then calls the
+ * specific free function. Car histories belong to the arena of their parking
+ * lot, so only their item is freed.
  * @param itemInfo The info item whose details are to be freed.
  */
 void freeInfo(info*);
 
+/**
+ * @brief Gives an info item back to the pool of info nodes.
+ * The details of the item are not freed.
+ * @param itemInfo The info item to release.
+ */
+void freeInfoItem(info *itemInfo);
+
+/**
+ * @brief Gets the pool of info nodes, to read its counters.
+ * @return nodePool*: The pool of info nodes.
+ */
+nodePool *getInfoPool();
+
 #endif
@@ -0,0 +1,156 @@
+/**
+ * @file input.c
+ * @brief This file contains the implementation of the input reader, that
+ * maps the input file in memory or reads it in large blocks.
+ */
+
+// Include necessary libraries and header files
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "input.h"
+#include "project.h"
+
+/**
+ * @brief Tries to map the input in memory, from its current offset.
+ * The input can be shared with a program that already read part of it, so the
+ * mapping starts at the page of the current offset and the lines are read
+ * from that offset. The mapping is read only, each line is copied to the line
+ * buffer before the tokenizer changes it. Writing to the mapping itself would
+ * copy every page of the input on its first write.
+ * @param reader A pointer to the inputReader structure.
+ * @return int: TRUE if the input was mapped, FALSE otherwise.
+ */
+static int mapInput(inputReader *reader){
+    struct stat inputStat;
+    off_t offset, mapStart;
+    void *mapping;
+
+    if (fstat(reader->fd, &inputStat) != 0 || !S_ISREG(inputStat.st_mode))
+        return FALSE;
+
+    offset = lseek(reader->fd, 0, SEEK_CUR);
+    if (offset < 0 || offset >= inputStat.st_size) return FALSE;
+    mapStart = offset - offset % sysconf(_SC_PAGESIZE);
+
+    mapping = mmap(NULL, inputStat.st_size - mapStart, PROT_READ, MAP_PRIVATE,
+        reader->fd, mapStart);
+    if (mapping == MAP_FAILED) return FALSE;
+
+    madvise(mapping, inputStat.st_size - mapStart, MADV_SEQUENTIAL);
+    reader->buffer = (char*) mapping;
+    reader->size = reader->used = inputStat.st_size - mapStart;
+    reader->position = offset - mapStart;
+    return TRUE;
+}
+
+inputReader *createInputReader(int fd){
+    inputReader *reader = (inputReader*) malloc(sizeof(inputReader));
+
+    reader->fd = fd;
+    reader->ended = FALSE;
+    reader->position = 0;
+    reader->lineSize = MAXLINE;
+    reader->line = (char*) malloc(sizeof(char) * reader->lineSize);
+    if ((reader->mapped = mapInput(reader)) == FALSE){
+        reader->size = INPUTCHUNK;
+        reader->used = 0;
+        reader->buffer = (char*) malloc(sizeof(char) * reader->size);
+    }
+    return reader;
+}
+
+/**
+ * @brief Reads the next block of the input into the buffer.
+ * The incomplete line at the end of the buffer is moved to its start, and the
+ * buffer grows if that line fills it. One byte is always kept free to
+ * terminate a last line without a newline.
+ * @param reader A pointer to the inputReader structure.
+ */
+static void fillBuffer(inputReader *reader){
+    ssize_t bytesRead;
+
+    memmove(reader->buffer, reader->buffer + reader->position,
+        reader->used - reader->position);
+    reader->used -= reader->position;
+    reader->position = 0;
+
+    if (reader->used + 1 >= reader->size){ // a line longer than the buffer
+        reader->size *= 2;
+        reader->buffer = (char*) realloc(reader->buffer, reader->size);
+    }
+
+    do{
+        bytesRead = read(reader->fd, reader->buffer + reader->used,
+            reader->size - reader->used - 1);
+    }while (bytesRead < 0 && errno == EINTR);
+
+    if (bytesRead <= 0) reader->ended = TRUE;
+    else reader->used += bytesRead;
+}
+
+/**
+ * @brief Gets the next line of a mapped input.
+ * The line is copied with its newline to the line buffer and terminated.
+ * @param reader A pointer to the inputReader structure.
+ * @return char*: The next line, or NULL if the input has ended.
+ */
+static char *nextMappedLine(inputReader *reader){
+    char *start = reader->buffer + reader->position, *newline;
+    size_t left = reader->size - reader->position, length;
+
+    if (left == 0) return NULL;
+
+    newline = (char*) memchr(start, '\n', left);
+    length = newline != NULL ? (size_t) (newline - start) + 1 : left;
+
+    if (length + 1 > reader->lineSize){ // a line longer than the buffer
+        reader->lineSize = length + 1;
+        reader->line = (char*) realloc(reader->line, reader->lineSize);
+    }
+    memcpy(reader->line, start, length);
+    reader->line[length] = '\0';
+    reader->position += length;
+    return reader->line;
+}
+
+/**
+ * @brief Gets the next line of an input read in blocks.
+ * @param reader A pointer to the inputReader structure.
+ * @return char*: The next line, or NULL if the input has ended.
+ */
+static char *nextBufferedLine(inputReader *reader){
+    char *start, *newline;
+
+    while (TRUE){
+        start = reader->buffer + reader->position;
+        newline = (char*) memchr(start, '\n', reader->used - reader->position);
+
+        if (newline != NULL){
+            reader->position = newline - reader->buffer + 1;
+            return start;
+        }
+        if (reader->ended){
+            if (reader->position == reader->used) return NULL;
+            reader->buffer[reader->used] = '\0'; // last line has no newline
+            reader->position = reader->used;
+            return start;
+        }
+        fillBuffer(reader);
+    }
+}
+
+char *nextLine(inputReader *reader){
+    if (reader->mapped) return nextMappedLine(reader);
+    return nextBufferedLine(reader);
+}
+
+void freeInputReader(inputReader *reader){
+    if (reader->mapped) munmap(reader->buffer, reader->size);
+    else free(reader->buffer);
+    free(reader->line);
+    free(reader);
+}
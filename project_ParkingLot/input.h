@@ -0,0 +1,62 @@
+/**
+ * @file input.h
+ * @brief This header file contains the declarations of the inputReader
+ * structure and related functions.
+ */
+
+// Check if the header file has already been included
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stddef.h>
+
+#define INPUTCHUNK 1048576 /**< The size of each block read from a stream. */
+#define MAXLINE 8192 /**< The initial size of the line buffer. */
+
+/**
+ * @struct inputReader
+ * @brief A structure to read the commands from a file descriptor.
+ * When the input is a regular file it is mapped in memory and the commands
+ * are read from the mapping. Otherwise, like for pipes or terminals, it is
+ * read in large blocks into a buffer.
+ */
+typedef struct inputReader{
+    int fd; /**< The file descriptor read. */
+    int mapped; /**< TRUE if the whole input is mapped in memory. */
+    int ended; /**< TRUE when the end of the input was reached. */
+    char *buffer; /**< The mapping or the buffer with the read data. */
+    size_t size; /**< The size of the mapping or of the buffer. */
+    size_t used; /**< The number of bytes of data in the buffer. */
+    size_t position; /**< The position of the next line in the buffer. */
+    char *line; /**< The copy of the current line of a mapped input. */
+    size_t lineSize; /**< The size of the line buffer. */
+}inputReader;
+
+/**
+ * @brief Creates a new inputReader structure.
+ * This function tries to map the file descriptor in memory from its current
+ * offset, if it is not a regular file, or the mapping fails, it allocates a
+ * buffer to read it in blocks.
+ * @param fd The file descriptor to read the commands from.
+ * @return inputReader*: A pointer to the created inputReader structure.
+ */
+inputReader *createInputReader(int fd);
+
+/**
+ * @brief Gets the next line of the input.
+ * The line can be changed by the tokenizer, it ends with a newline or with a
+ * '\0' if it is the last line of the input. The line stays valid until the
+ * next call.
+ * @param reader A pointer to the inputReader structure.
+ * @return char*: The next line, or NULL if the input has ended.
+ */
+char *nextLine(inputReader *reader);
+
+/**
+ * @brief Frees the memory allocated for an inputReader structure.
+ * This function unmaps the input or frees the buffer used to read it.
+ * @param reader A pointer to the inputReader structure.
+ */
+void freeInputReader(inputReader *reader);
+
+#endif
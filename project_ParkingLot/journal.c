@@ -0,0 +1,384 @@
+/**
+ * @file journal.c
+ * @brief This file contains the implementation of the journal of accepted
+ * commands, written in binary records, and of its reader.
+ */
+
+// Include necessary libraries and header files
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "journal.h"
+#include "project.h"
+
+journalReader *openJournalReader(char *path){
+    journalReader *reader;
+    struct stat fileStat;
+    void *mapping;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) return NULL;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size < JOURNALMAGICSIZE){
+        close(fd);
+        return NULL;
+    }
+
+    mapping = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // the mapping stays valid
+    if (mapping == MAP_FAILED) return NULL;
+    madvise(mapping, fileStat.st_size, MADV_SEQUENTIAL);
+
+    reader = (journalReader*) malloc(sizeof(journalReader));
+    reader->mapping = (char*) mapping;
+    reader->size = fileStat.st_size;
+    reader->position = JOURNALMAGICSIZE;
+    return reader;
+}
+
+int hasJournalMagic(journalReader *reader){
+    return memcmp(reader->mapping, JOURNALMAGIC, JOURNALMAGICSIZE) == 0;
+}
+
+/**
+ * @brief Copies the next bytes of the journal being read.
+ * @param reader A pointer to the journalReader structure.
+ * @param offset Where the bytes are read, moved past them.
+ * @param field Where the bytes are copied to.
+ * @param size The number of bytes.
+ * @return int: TRUE if the file had the bytes, FALSE otherwise.
+ */
+static int readField(journalReader *reader, size_t *offset, void *field,
+    size_t size){
+
+    if (reader->size - *offset < size) return FALSE;
+    memcpy(field, reader->mapping + *offset, size);
+    *offset += size;
+    return TRUE;
+}
+
+/**
+ * @brief Updates the FNV-1a checksum of a record with some bytes.
+ * @param checksum The checksum of the bytes before.
+ * @param bytes The bytes.
+ * @param size The number of bytes.
+ * @return unsigned int: The checksum with the bytes.
+ */
+static unsigned int addToChecksum(unsigned int checksum, char *bytes,
+    size_t size){
+
+    while (size-- > 0)
+        checksum = (checksum ^ (unsigned char) *bytes++) * CHECKSUMPRIME;
+    return checksum;
+}
+
+/**
+ * @brief Reads the fields of the creation of a park after its type.
+ * The name is kept in the record with its '\0', so it is used from the
+ * mapping without a copy.
+ * @param reader A pointer to the journalReader structure.
+ * @param offset Where the fields are read, moved past them.
+ * @param record Where the fields are stored.
+ * @return int: TRUE if the fields were complete, FALSE otherwise.
+ */
+static int readParkFields(journalReader *reader, size_t *offset,
+    journalRecord *record){
+
+    unsigned int nameLength;
+
+    if (!readField(reader, offset, &record->capacity, sizeof(int)) ||
+        !readField(reader, offset, &record->initialFee, sizeof(millicents)) ||
+        !readField(reader, offset, &record->laterFee, sizeof(millicents)) ||
+        !readField(reader, offset, &record->maxFee, sizeof(millicents)) ||
+        !readField(reader, offset, &nameLength, sizeof(unsigned int)))
+            return FALSE;
+
+    if (nameLength == 0 || reader->size - *offset < nameLength ||
+        reader->mapping[*offset + nameLength - 1] != '\0')
+            return FALSE;
+
+    record->name = reader->mapping + *offset;
+    *offset += nameLength;
+    return TRUE;
+}
+
+int nextJournalRecord(journalReader *reader, journalRecord *record){
+    size_t offset = reader->position;
+    unsigned int checksum;
+    int complete;
+
+    if (!readField(reader, &offset, &record->type, sizeof(char)) ||
+        !readField(reader, &offset, &record->park, sizeof(unsigned int)))
+            return FALSE;
+
+    switch (record->type){
+        case JOURNALENTRY:
+        case JOURNALEXIT:
+            complete = readField(reader, &offset, &record->registration,
+                sizeof(plate)) && readField(reader, &offset, &record->time,
+                sizeof(dateAndHour));
+            break;
+        case JOURNALPARK:
+            complete = readParkFields(reader, &offset, record);
+            break;
+        case JOURNALREMOVAL:
+            complete = TRUE;
+            break;
+        default: // not a record, like the zeros left by a crash
+            complete = FALSE;
+    }
+
+    if (!complete || !readField(reader, &offset, &checksum,
+        sizeof(unsigned int)) || checksum != addToChecksum(CHECKSUMBASIS,
+        reader->mapping + reader->position,
+        offset - sizeof(unsigned int) - reader->position))
+            return FALSE;
+
+    record->offset = reader->position;
+    reader->position = offset;
+    return TRUE;
+}
+
+int skipJournalRecords(journalReader *reader, long offset){
+    if (offset < JOURNALMAGICSIZE || (size_t) offset > reader->size)
+        return FALSE;
+    reader->position = offset;
+    return TRUE;
+}
+
+long getJournalReaderOffset(journalReader *reader){
+    return reader->position;
+}
+
+void freeJournalReader(journalReader *reader){
+    munmap(reader->mapping, reader->size);
+    free(reader);
+}
+
+/**
+ * @brief Writes some bytes to the journal file.
+ * @param log A pointer to the journal structure.
+ * @param data The bytes to write.
+ * @param size The number of bytes.
+ * @return long: The number of bytes written, less than size if it failed.
+ */
+static long writeAll(journal *log, char *data, long size){
+    long done = 0;
+    ssize_t written;
+
+    while (done < size){
+        written = write(log->fd, data + done, size - done);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) break; // the disk is full or failed
+        done += written;
+    }
+    return done;
+}
+
+/**
+ * @brief Marks a journal as failed, dropping its buffered records.
+ * @param log A pointer to the journal structure.
+ * @param end The number of bytes that reached the file.
+ */
+static void failJournal(journal *log, long end){
+    log->failed = TRUE;
+    log->size = end;
+    log->used = 0;
+}
+
+int flushJournal(journal *log){
+    long written;
+
+    if (log == NULL) return TRUE;
+    if (log->failed) return FALSE;
+    written = writeAll(log, log->buffer, log->used);
+    if (written < log->used){
+        failJournal(log, log->size - log->used + written);
+        return FALSE;
+    }
+    log->used = 0;
+    return TRUE;
+}
+
+/**
+ * @brief Adds some bytes of a record to the buffer of a journal.
+ * @param log A pointer to the journal structure.
+ * @param data The bytes to add.
+ * @param size The number of bytes.
+ */
+static void appendBytes(journal *log, void *data, size_t size){
+    char *bytes = (char*) data;
+    size_t part;
+
+    if (log->failed) return; // its size stays at the end of the file
+    log->checksum = addToChecksum(log->checksum, bytes, size);
+    log->size += size;
+    while (size > 0){ // only the name of a park can fill the buffer
+        if (log->used == JOURNALBUFFER) flushJournal(log);
+        part = JOURNALBUFFER - log->used;
+        if (part > size) part = size;
+
+        memcpy(log->buffer + log->used, bytes, part);
+        log->used += part;
+        bytes += part;
+        size -= part;
+    }
+}
+
+/**
+ * @brief Ends a record of a journal with its checksum, syncing the file after
+ * JOURNALBATCH records.
+ * @param log A pointer to the journal structure.
+ */
+static void endRecord(journal *log){
+    unsigned int checksum = log->checksum;
+
+    appendBytes(log, &checksum, sizeof(unsigned int));
+    log->checksum = CHECKSUMBASIS; // for the next record
+    if (++log->unsynced >= JOURNALBATCH) syncJournal(log);
+}
+
+int syncParentDirectory(char *path){
+    char *slash = strrchr(path, '/'), *directory;
+    long length = slash == NULL ? 0 : slash - path;
+    int fd, synced;
+
+    directory = (char*) malloc(length + 2);
+    if (slash == NULL) strcpy(directory, ".");
+    else if (length == 0) strcpy(directory, "/");
+    else{
+        memcpy(directory, path, length);
+        directory[length] = '\0';
+    }
+    fd = open(directory, O_RDONLY | O_DIRECTORY);
+    free(directory);
+    if (fd < 0) return FALSE;
+
+    synced = fsync(fd) == 0;
+    close(fd);
+    return synced;
+}
+
+journal *openJournal(char *path, long validBytes){
+    journal *log;
+    int fd = open(path, O_WRONLY | O_CREAT, 0644);
+
+    if (fd < 0) return NULL;
+    if (ftruncate(fd, validBytes) != 0 || lseek(fd, 0, SEEK_END) < 0){
+        close(fd);
+        return NULL;
+    }
+
+    log = (journal*) malloc(sizeof(journal));
+    log->fd = fd;
+    log->used = 0;
+    log->unsynced = 0;
+    log->size = validBytes;
+    log->checksum = CHECKSUMBASIS;
+    log->failed = FALSE;
+    if (validBytes == 0){ // a new journal
+        appendBytes(log, JOURNALMAGIC, JOURNALMAGICSIZE);
+        if (!syncJournal(log) || !syncParentDirectory(path)){
+            closeJournal(log);
+            return NULL;
+        }
+        log->checksum = CHECKSUMBASIS; // the magic is not in a record
+    }
+    return log;
+}
+
+void journalPark(journal *log, parkingLot *park){
+    char type = JOURNALPARK;
+    unsigned int number, nameLength;
+    int capacity;
+    millicents fee;
+
+    if (log == NULL) return;
+    number = getParkNumber(park);
+    capacity = getParkCapacity(park);
+    nameLength = strlen(getParkName(park)) + 1;
+
+    appendBytes(log, &type, sizeof(char));
+    appendBytes(log, &number, sizeof(unsigned int));
+    appendBytes(log, &capacity, sizeof(int));
+    fee = getParkInitialFee(park);
+    appendBytes(log, &fee, sizeof(millicents));
+    fee = getParkLaterFee(park);
+    appendBytes(log, &fee, sizeof(millicents));
+    fee = getParkMaxFee(park);
+    appendBytes(log, &fee, sizeof(millicents));
+    appendBytes(log, &nameLength, sizeof(unsigned int));
+    appendBytes(log, getParkName(park), nameLength);
+    endRecord(log);
+}
+
+/**
+ * @brief Adds the entry or exit of a vehicle to a journal.
+ * @param log A pointer to the journal structure.
+ * @param type JOURNALENTRY or JOURNALEXIT.
+ * @param park The number of the park.
+ * @param registration The plate of the vehicle.
+ * @param time The date and hour of the entry or exit.
+ */
+static void journalMove(journal *log, char type, unsigned int park,
+    plate registration, dateAndHour time){
+
+    if (log == NULL) return;
+    appendBytes(log, &type, sizeof(char));
+    appendBytes(log, &park, sizeof(unsigned int));
+    appendBytes(log, &registration, sizeof(plate));
+    appendBytes(log, &time, sizeof(dateAndHour));
+    endRecord(log);
+}
+
+void journalEntry(journal *log, unsigned int park, plate registration,
+    dateAndHour time){
+
+    journalMove(log, JOURNALENTRY, park, registration, time);
+}
+
+void journalExit(journal *log, unsigned int park, plate registration,
+    dateAndHour time){
+
+    journalMove(log, JOURNALEXIT, park, registration, time);
+}
+
+void journalRemoval(journal *log, unsigned int park){
+    char type = JOURNALREMOVAL;
+
+    if (log == NULL) return;
+    appendBytes(log, &type, sizeof(char));
+    appendBytes(log, &park, sizeof(unsigned int));
+    endRecord(log);
+}
+
+long getJournalSize(journal *log){
+    if (log == NULL) return 0;
+    return log->size;
+}
+
+int syncJournal(journal *log){
+    if (log == NULL) return TRUE;
+    if (log->failed || (log->used == 0 && log->unsynced == 0))
+        return !log->failed;
+    if (!flushJournal(log)) return FALSE;
+    if (fsync(log->fd) != 0){ // the written records may not be kept
+        failJournal(log, log->size);
+        return FALSE;
+    }
+    log->unsynced = 0;
+    return TRUE;
+}
+
+int closeJournal(journal *log){
+    int synced;
+
+    if (log == NULL) return TRUE;
+    synced = syncJournal(log);
+    close(log->fd);
+    free(log);
+    return synced;
+}
@@ -0,0 +1,218 @@
+/**
+ * @file journal.h
+ * @brief This header file contains the declarations of the journal of
+ * accepted commands, its reader and related functions.
+ */
+
+// Check if the header file has already been included
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+// Include necessary library and header files
+#include <stddef.h>
+#include "carPlate.h"
+#include "dateAndHour.h"
+
+#define JOURNALMAGIC "PKJ2" /**< The first bytes of a journal file. */
+#define JOURNALMAGICSIZE 4 /**< The number of bytes of the magic. */
+#define JOURNALBUFFER 65536 /**< The size of the buffer of records. */
+#define JOURNALBATCH 4096 /**< The number of records written per fsync. */
+#define CHECKSUMBASIS 2166136261u /**< The checksum of no bytes. */
+#define CHECKSUMPRIME 16777619u /**< The multiplier of the checksum. */
+
+// Define constants to identify record types
+#define JOURNALPARK 'p'
+#define JOURNALENTRY 'e'
+#define JOURNALEXIT 's'
+#define JOURNALREMOVAL 'r'
+
+// Forward declaration of structures
+typedef struct parkingLot parkingLot;
+
+/**
+ * @struct journal
+ * @brief A structure to represent the journal of the accepted commands that
+ * change the state. Records are kept in a buffer and written to the end of
+ * the file before any answer is written, so a crash of the program never
+ * loses a command it answered. The file is synced with fsync once per
+ * JOURNALBATCH records, so many records share the cost of one sync. Each
+ * record ends with an FNV-1a checksum of its bytes, so one damaged by a crash
+ * is not replayed. Once a write or a sync fails, the journal is failed and
+ * nothing more is added to it.
+ */
+typedef struct journal{
+    int fd; /**< The file descriptor of the journal file. */
+    char buffer[JOURNALBUFFER]; /**< The records not yet written. */
+    int used; /**< The number of bytes in the buffer. */
+    int unsynced; /**< The number of records since the last sync. */
+    unsigned int checksum; /**< The checksum of the current record. */
+    long size; /**< The number of bytes of the file, with the buffered ones,
+        only the ones written once the journal failed. */
+    int failed; /**< TRUE once a write or a sync failed. */
+}journal;
+
+/**
+ * @struct journalRecord
+ * @brief A structure to represent a record read from a journal. Only the
+ * fields of its type are set. Parks are identified by their number, the
+ * order in which they were created.
+ */
+typedef struct journalRecord{
+    char type; /**< The type of the record, JOURNALPARK, JOURNALENTRY,
+        JOURNALEXIT or JOURNALREMOVAL. */
+    unsigned int park; /**< The number of the park. */
+    plate registration; /**< The plate of the vehicle of an entry or exit. */
+    dateAndHour time; /**< The date and hour of an entry or exit. */
+    char *name; /**< The name of a new park, valid until the next record. */
+    int capacity; /**< The capacity of a new park. */
+    millicents initialFee; /**< The initial fee of a new park. */
+    millicents laterFee; /**< The later fee of a new park. */
+    millicents maxFee; /**< The maximum fee of a new park. */
+    long offset; /**< The offset of the record in the file. */
+}journalRecord;
+
+/**
+ * @struct journalReader
+ * @brief A structure to read the records of a journal file, mapped in memory.
+ */
+typedef struct journalReader{
+    char *mapping; /**< The mapping of the file. */
+    size_t size; /**< The size of the file. */
+    size_t position; /**< The position after the last complete record. */
+}journalReader;
+
+/**
+ * @brief Opens a journal file to read its records.
+ * @param path The path of the journal file.
+ * @return journalReader*: A pointer to the created reader, or NULL if the
+ * file does not exist or is too short to have the magic.
+ */
+journalReader *openJournalReader(char *path);
+
+/**
+ * @brief Checks if a file read starts with the magic of a journal.
+ * @param reader A pointer to the journalReader structure.
+ * @return int: TRUE if the file is a journal, FALSE otherwise.
+ */
+int hasJournalMagic(journalReader *reader);
+
+/**
+ * @brief Reads the next record of a journal.
+ * A record cut by the end of the file, as left by a crash while writing it,
+ * of an unknown type or with a wrong checksum, is not read.
+ * @param reader A pointer to the journalReader structure.
+ * @param record Where the fields of the record are stored.
+ * @return int: TRUE if a complete record was read, FALSE otherwise.
+ */
+int nextJournalRecord(journalReader *reader, journalRecord *record);
+
+/**
+ * @brief Skips the records of a journal before an offset.
+ * It is used to read only the records after a snapshot.
+ * @param reader A pointer to the journalReader structure.
+ * @param offset The offset of the first record to read.
+ * @return int: TRUE if the file has that many bytes, FALSE otherwise.
+ */
+int skipJournalRecords(journalReader *reader, long offset);
+
+/**
+ * @brief Gets the number of bytes of the magic and the records read.
+ * @param reader A pointer to the journalReader structure.
+ * @return long: The offset after the last record read.
+ */
+long getJournalReaderOffset(journalReader *reader);
+
+/**
+ * @brief Unmaps the file and frees a journalReader structure.
+ * @param reader A pointer to the journalReader structure.
+ */
+void freeJournalReader(journalReader *reader);
+
+/**
+ * @brief Syncs the directory of a file, so a file created or renamed in it
+ * is kept after a crash.
+ * @param path The path of the file.
+ * @return int: TRUE if the directory was synced, FALSE otherwise.
+ */
+int syncParentDirectory(char *path);
+
+/**
+ * @brief Opens a journal file to add records to its end.
+ * The file is created if it does not exist, and cut after its valid bytes,
+ * so a record left incomplete by a crash is overwritten. A file without
+ * valid bytes gets the magic, and its directory is synced so the file itself
+ * survives a crash.
+ * @param path The path of the journal file.
+ * @param validBytes The number of bytes of the magic and the valid records.
+ * @return journal*: A pointer to the created journal, NULL if the file could
+ * not be opened or its magic could not be written.
+ */
+journal *openJournal(char *path, long validBytes);
+
+/**
+ * @brief Adds the creation of a park to a journal.
+ * If the journal is NULL nothing is added, like in the functions below.
+ * @param log A pointer to the journal structure.
+ * @param park A pointer to the new park.
+ */
+void journalPark(journal *log, parkingLot *park);
+
+/**
+ * @brief Adds the entry of a vehicle in a park to a journal.
+ * @param log A pointer to the journal structure.
+ * @param park The number of the park.
+ * @param registration The plate of the vehicle.
+ * @param time The date and hour of the entry.
+ */
+void journalEntry(journal *log, unsigned int park, plate registration,
+    dateAndHour time);
+
+/**
+ * @brief Adds the exit of a vehicle from a park to a journal.
+ * The fee is not kept, it is calculated again on replay.
+ * @param log A pointer to the journal structure.
+ * @param park The number of the park.
+ * @param registration The plate of the vehicle.
+ * @param time The date and hour of the exit.
+ */
+void journalExit(journal *log, unsigned int park, plate registration,
+    dateAndHour time);
+
+/**
+ * @brief Adds the removal of a park to a journal.
+ * @param log A pointer to the journal structure.
+ * @param park The number of the park.
+ */
+void journalRemoval(journal *log, unsigned int park);
+
+/**
+ * @brief Gets the size a journal file has after its buffered records.
+ * @param log A pointer to the journal structure.
+ * @return long: The number of bytes of the magic and all the records, 0 if
+ * the journal is NULL. After a failure, only the bytes that reached the file.
+ */
+long getJournalSize(journal *log);
+
+/**
+ * @brief Writes the buffered records of a journal to its file, without a
+ * sync, so they survive a crash of the program.
+ * @param log A pointer to the journal structure, or NULL.
+ * @return int: FALSE if the journal failed, now or before, TRUE otherwise.
+ */
+int flushJournal(journal *log);
+
+/**
+ * @brief Writes the buffered records of a journal and syncs the file.
+ * @param log A pointer to the journal structure, or NULL.
+ * @return int: FALSE if the journal failed, now or before, TRUE otherwise.
+ */
+int syncJournal(journal *log);
+
+/**
+ * @brief Syncs and closes a journal, and frees the journal structure.
+ * @param log A pointer to the journal structure, or NULL.
+ * @return int: FALSE if the journal failed, TRUE otherwise.
+ */
+int closeJournal(journal *log);
+
+#endif
@@ -70,14 +70,6 @@ void addItemInOrder(list* listItems, info *item){
         }
 
     }
-    else if (getInfoType(item) == ISPARKEDCARS){
-        date *dateToSearch = getParkedCarsDate(getParkedCarsInfo(item));
-        while( currentItem != NULL &&
-            dateIsNewerThen( getParkedCarsDate( getParkedCarsInfo(currentItem)),
-                dateToSearch))
-
-            currentItem = getPreviousItem(currentItem);
-    }
     insertItemInList(listItems, currentItem, item);
 }
 
@@ -115,9 +107,7 @@ info *searchForItem(list *listItems, char *identifier){
     return tempItem;
 }
 
-info* popItem(list* listItems, char* identifier){
-    info *itemToPop = searchForItem(listItems, identifier);
-
+info *unlinkItem(list *listItems, info *itemToPop){
     if (itemToPop == NULL) return NULL;
     if (getListSize(listItems) == 1){
         changeFirstItem(listItems, NULL);
@@ -140,6 +130,10 @@ info* popItem(list* listItems, char* identifier){
     return itemToPop;
 }
 
+info* popItem(list* listItems, char* identifier){
+    return unlinkItem(listItems, searchForItem(listItems, identifier));
+}
+
 void freeList(list* listItems){
     info* currentInfo;
 
@@ -150,51 +144,12 @@ void freeList(list* listItems){
     free(listItems);
 }
 
-void freeParkedCarsEntries(list* parkHist, char* parkName){
-    info *currDayHist;
-
-    while((currDayHist = getFirstItem(parkHist)) != NULL){
-        list* parkedVeh = getParkedCarsList(getParkedCarsInfo(currDayHist));
-
-        // free entries of cars parked in the park
-        freeCarEntries(parkedVeh, parkName);
-
-        changeFirstItem(parkHist, getNextItem(currDayHist));
-        freeInfo(currDayHist); // free the day of park history
-    }
-    free(parkHist);
-}
-
-void freeCarEntries(list* parkedVeh, char* parkName){
-    info *currCarInfo;
-
-    while ((currCarInfo = getFirstItem(parkedVeh)) != NULL){
-        vehicle* currentCar = getCarInfo(currCarInfo);
-        info* carHistSect; // car history section
-        carHistSect = searchForItem(getCarPastParked(currentCar), parkName);
-
-        if (carHistSect != NULL) // free the car history section
-            freeInfo(popItem(getCarPastParked(currentCar), parkName));
-
-        if (getCarParkedParkName(currentCar) != NULL &&
-            strcmp(getCarParkedParkName(currentCar), parkName) == 0)
-                changeCarParkedParkName(currentCar, NULL);
-
-        changeFirstItem(parkedVeh, getNextItem(currCarInfo));
-
-        if (getInfoType(currCarInfo) == ISEXITVEHICLE)
-            freeExitVehicle(getExitVehicleInfo(currCarInfo));
-
-        free(currCarInfo);
-    }
-}
-
 void shallowFreeList(list *listItems){
     info *tempItem;
 
     while((tempItem = getFirstItem(listItems)) != NULL){
         changeFirstItem(listItems, getNextItem(tempItem));
-        free(tempItem);
+        freeInfoItem(tempItem);
     }
     free(listItems);
 }
@@ -139,31 +139,20 @@ info* searchForItem(list* listItems, char* identifier);
 info* popItem(list* listItems, char* identifier);
 
 /**
- * @brief Frees the memory allocated for a list and its items.
- * @param listItems The list to be freed.
- */
-void freeList(list *listItems);
-
-/**
- * @brief Frees memory for parked cars entries in a park history list.
- * Iterates over the park history list, freeing memory for each vehicle entry
- * that matches the provided park name. After processing all entries, it frees
- * the memory for the park history list itself.
- * @param parkHist A pointer to the park history list.
- * @param parkName The name of the park for which to free parked car entries.
+ * @brief Unlinks an item from a list.
+ * This function adjusts the links of the list around the item and decrements
+ * its size by 1. The item itself is not freed.
+ * @param listItems A pointer to the list.
+ * @param itemToPop A pointer to the item to unlink, NULL does nothing.
+ * @return info*: The unlinked item.
  */
-void freeParkedCarsEntries(list *parkHist, char *parkName);
+info *unlinkItem(list *listItems, info *itemToPop);
 
 /**
- * @brief Frees memory for car entries in a vehicles list.
- * Iterates over the vehicles list. For each vehicle, if it has a history
- * section matching the provided park name, that section is freed. After
- * processing all vehicles, it frees the memory for the vehicles list.
- * @param parkedVeh A pointer to the list of parked vehicles.
- * @param parkName The name of the park for which to free car entries.
+ * @brief Frees the memory allocated for a list and its items.
+ * @param listItems The list to be freed.
  */
-void freeCarEntries(list *parkedVeh, char *parkName);
-
+void freeList(list *listItems);
 
 /**
  * @brief Performs a shallow free operation on a list.
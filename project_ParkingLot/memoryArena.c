@@ -0,0 +1,109 @@
+/**
+ * @file memoryArena.c
+ * @brief This file contains the implementation of the memory arenas.
+ */
+
+// Include necessary libraries and header file
+#include <stdlib.h>
+#include <string.h>
+#include "memoryArena.h"
+
+memoryArena *createArena(){
+    memoryArena *arena = (memoryArena*) calloc(1, sizeof(memoryArena));
+
+    return arena; // no chunk until the first block
+}
+
+/**
+ * @brief Rounds the size of a block up to the alignment of the arena.
+ * @param size The size asked for.
+ * @return size_t: The size of the block given.
+ */
+static size_t alignedSize(size_t size){
+    return (size + ARENAALIGN - 1) / ARENAALIGN * ARENAALIGN;
+}
+
+/**
+ * @brief Gets the class of the blocks of an aligned size.
+ * Sizes up to ARENASMALLBLOCK have a class each, larger ones only if they
+ * are a power of 2.
+ * @param size The aligned size of the block.
+ * @return int: The class of the size, -1 if blocks of that size are not
+ * recycled.
+ */
+static int blockClass(size_t size){
+    int class = 0;
+
+    if (size < sizeof(void*)) return -1;
+    if (size <= ARENASMALLBLOCK) return size / ARENAALIGN - 1;
+    if ((size & (size - 1)) != 0) return -1;
+    while (((size_t) ARENASMALLBLOCK << class) < size) class++;
+    class += ARENASMALLBLOCK / ARENAALIGN - 1; // after the small classes
+    return class < ARENACLASSES ? class : -1;
+}
+
+/**
+ * @brief Takes a new chunk from malloc and links it to the arena.
+ * @param arena A pointer to the arena.
+ * @param size The number of bytes after the header of the chunk.
+ * @return char*: The first byte after the header.
+ */
+static char *addChunk(memoryArena *arena, size_t size){
+    char *chunk = (char*) malloc(ARENAALIGN + size);
+
+    *(void**) chunk = arena->chunks; // the header links the chunks
+    arena->chunks = chunk;
+    return chunk + ARENAALIGN;
+}
+
+void *arenaAllocate(memoryArena *arena, size_t size){
+    int class = blockClass(size = alignedSize(size));
+    char *block;
+
+    if (class >= 0 && arena->freeBlocks[class] != NULL){ // a recycled block
+        block = (char*) arena->freeBlocks[class];
+        arena->freeBlocks[class] = *(void**) block;
+        return block;
+    }
+
+    if (size > ARENACHUNK / 4)
+        return addChunk(arena, size); // the current chunk is kept
+
+    if (arena->next == NULL || (size_t) (arena->end - arena->next) < size){
+        arena->next = addChunk(arena, ARENACHUNK);
+        arena->end = arena->next + ARENACHUNK;
+    }
+    block = arena->next;
+    arena->next += size;
+    return block;
+}
+
+void arenaRelease(memoryArena *arena, void *block, size_t size){
+    int class = blockClass(alignedSize(size));
+
+    if (class < 0) return; // kept until the arena is freed
+    *(void**) block = arena->freeBlocks[class];
+    arena->freeBlocks[class] = block;
+}
+
+void *arenaGrow(memoryArena *arena, void *block, size_t oldSize,
+    size_t newSize){
+
+    void *newBlock = arenaAllocate(arena, newSize);
+
+    if (block != NULL){
+        memcpy(newBlock, block, oldSize);
+        arenaRelease(arena, block, oldSize); // for another of the same size
+    }
+    return newBlock;
+}
+
+void freeArena(memoryArena *arena){
+    void *chunk, *previousChunk;
+
+    for (chunk = arena->chunks; chunk != NULL; chunk = previousChunk){
+        previousChunk = *(void**) chunk;
+        free(chunk);
+    }
+    free(arena);
+}
@@ -0,0 +1,78 @@
+/**
+ * @file memoryArena.h
+ * @brief This header file contains the declarations of the memoryArena
+ * structure and related functions.
+ */
+
+// Check if the header file has already been included
+#ifndef MEMORYARENA_H
+#define MEMORYARENA_H
+
+// Include necessary library
+#include <stddef.h>
+
+#define ARENACHUNK 65536 /**< The size of the chunks taken by an arena. */
+#define ARENAALIGN 8 /**< The alignment of the blocks of an arena. */
+#define ARENASMALLBLOCK 256 /**< The largest block recycled by its size. */
+#define ARENACLASSES 56 /**< The number of sizes of recycled blocks. */
+
+/**
+ * @struct memoryArena
+ * @brief A structure to represent an arena of memory. The arena takes chunks
+ * of ARENACHUNK bytes from malloc and gives blocks from the current chunk in
+ * order. Blocks are not freed one by one, they are all freed with the arena.
+ * Blocks released or replaced by a larger copy are kept by size and given
+ * again before the chunk is used, if they are up to ARENASMALLBLOCK bytes or
+ * their size is a power of 2.
+ */
+typedef struct memoryArena{
+    void *chunks; /**< The last chunk, each starts with the previous one. */
+    char *next; /**< The first free byte of the current chunk. */
+    char *end; /**< The end of the current chunk. */
+    void *freeBlocks[ARENACLASSES]; /**< The first recycled block of each
+        size, each holds the next one. */
+}memoryArena;
+
+/**
+ * @brief Creates a new memoryArena structure without chunks.
+ * @return memoryArena*: A pointer to the created arena.
+ */
+memoryArena *createArena();
+
+/**
+ * @brief Gets a block of memory from an arena.
+ * Blocks larger than a quarter of a chunk get a chunk of their own.
+ * @param arena A pointer to the arena.
+ * @param size The size of the block.
+ * @return void*: A pointer to the block, aligned to ARENAALIGN.
+ */
+void *arenaAllocate(memoryArena *arena, size_t size);
+
+/**
+ * @brief Gives a block back to an arena, to be given again for the same size.
+ * Blocks of other sizes are only freed with the arena.
+ * @param arena A pointer to the arena.
+ * @param block A pointer to the block.
+ * @param size The size of the block.
+ */
+void arenaRelease(memoryArena *arena, void *block, size_t size);
+
+/**
+ * @brief Replaces a block of an arena by a larger one with the same start.
+ * The old block is released with arenaRelease.
+ * @param arena A pointer to the arena.
+ * @param block A pointer to the block, NULL if there is none yet.
+ * @param oldSize The size of the block.
+ * @param newSize The size of the new block.
+ * @return void*: A pointer to the new block.
+ */
+void *arenaGrow(memoryArena *arena, void *block, size_t oldSize,
+    size_t newSize);
+
+/**
+ * @brief Frees an arena and all its blocks.
+ * @param arena A pointer to the arena.
+ */
+void freeArena(memoryArena *arena);
+
+#endif
@@ -0,0 +1,87 @@
+/**
+ * @file nodePool.c
+ * @brief This file contains the implementation of the pools of nodes.
+ */
+
+// Include necessary library and header file
+#include <stdlib.h>
+#include "nodePool.h"
+
+static nodePool *allPools = NULL; /**< The pools that have slabs. */
+
+/**
+ * @brief Takes a new slab from malloc and puts its nodes in the free list.
+ * The first slab of a pool rounds the size of its nodes to POOLALIGN, so
+ * every node can hold a pointer and is aligned.
+ * @param pool A pointer to the pool.
+ */
+static void growNodePool(nodePool *pool){
+    char *slab, *node;
+    int count;
+
+    if (pool->slabCount == 0){
+        if (pool->nodeSize < sizeof(void*)) pool->nodeSize = sizeof(void*);
+        pool->nodeSize = (pool->nodeSize + POOLALIGN - 1) /
+            POOLALIGN * POOLALIGN;
+        pool->nextPool = allPools;
+        allPools = pool;
+    }
+
+    slab = (char*) malloc(POOLALIGN + pool->nodeSize * SLABNODES);
+    *(void**) slab = pool->slabs; // the header links the slabs
+    pool->slabs = slab;
+    pool->slabCount++;
+
+    // the first node of the slab ends up first in the free list
+    for (count = SLABNODES - 1; count >= 0; count--){
+        node = slab + POOLALIGN + pool->nodeSize * count;
+        *(void**) node = pool->freeNodes;
+        pool->freeNodes = node;
+    }
+}
+
+void *allocateNode(nodePool *pool){
+    void *node;
+
+    if (pool->freeNodes == NULL) growNodePool(pool);
+
+    node = pool->freeNodes;
+    pool->freeNodes = *(void**) node;
+    pool->allocations++;
+    pool->nodesInUse++;
+    return node;
+}
+
+void releaseNode(nodePool *pool, void *node){
+    *(void**) node = pool->freeNodes;
+    pool->freeNodes = node;
+    pool->nodesInUse--;
+}
+
+long getPoolAllocations(nodePool *pool){
+    return pool->allocations;
+}
+
+long getPoolNodesInUse(nodePool *pool){
+    return pool->nodesInUse;
+}
+
+long getPoolSlabCount(nodePool *pool){
+    return pool->slabCount;
+}
+
+void freeAllNodePools(){
+    nodePool *pool;
+    void *slab, *previousSlab;
+
+    for (pool = allPools; pool != NULL; pool = pool->nextPool){
+        for (slab = pool->slabs; slab != NULL; slab = previousSlab){
+            previousSlab = *(void**) slab;
+            free(slab);
+        }
+        pool->freeNodes = NULL;
+        pool->slabs = NULL;
+        pool->slabCount = 0;
+    }
+    allPools = NULL;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file nodePool.h
+ * @brief This header file contains the declarations of the nodePool
+ * structure and related functions.
+ */
+
+// Check if the header file has already been included
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+// Include necessary library
+#include <stddef.h>
+
+#define SLABNODES 256 /**< The number of nodes allocated at once by a pool. */
+#define POOLALIGN 8 /**< The alignment of the nodes of a pool. */
+
+/**
+ * @brief The initial value of the pool of a structure.
+ * @param type The structure whose nodes the pool gives.
+ */
+#define NODEPOOL(type) {sizeof(type), NULL, NULL, 0, 0, 0, NULL}
+
+/**
+ * @struct nodePool
+ * @brief A structure to represent a pool of nodes of the same size. The pool
+ * takes memory from malloc a slab of SLABNODES nodes at a time, and keeps the
+ * released nodes in a free list so they are given again before a new slab is
+ * needed. Slabs are only freed by freeAllNodePools.
+ */
+typedef struct nodePool{
+    size_t nodeSize; /**< The size of a node. */
+    void *freeNodes; /**< The first free node, each holds the next one. */
+    void *slabs; /**< The last slab, each starts with the previous one. */
+    long allocations; /**< The count of nodes given by the pool. */
+    long nodesInUse; /**< The count of nodes given and not yet released. */
+    long slabCount; /**< The count of slabs taken from malloc. */
+    struct nodePool *nextPool; /**< The next pool with slabs. */
+}nodePool;
+
+/**
+ * @brief Gets a node from a pool.
+ * @param pool A pointer to the pool.
+ * @return void*: A pointer to the node, with room for nodeSize bytes.
+ */
+void *allocateNode(nodePool *pool);
+
+/**
+ * @brief Gives a node back to its pool.
+ * @param pool A pointer to the pool the node came from.
+ * @param node A pointer to the node.
+ */
+void releaseNode(nodePool *pool, void *node);
+
+/**
+ * @brief Gets the count of nodes given by a pool.
+ * @param pool A pointer to the pool.
+ * @return long: The count of allocations.
+ */
+long getPoolAllocations(nodePool *pool);
+
+/**
+ * @brief Gets the count of nodes of a pool that are in use.
+ * @param pool A pointer to the pool.
+ * @return long: The count of nodes not yet released.
+ */
+long getPoolNodesInUse(nodePool *pool);
+
+/**
+ * @brief Gets the count of slabs of a pool.
+ * @param pool A pointer to the pool.
+ * @return long: The count of slabs taken from malloc.
+ */
+long getPoolSlabCount(nodePool *pool);
+
+/**
+ * @brief Frees the slabs of every pool.
+ * All the nodes given by the pools must be out of use.
+ */
+void freeAllNodePools();
+
+#endif
@@ -0,0 +1,124 @@
+/**
+ * @file output.c
+ * @brief This file contains the implementation of the buffered output.
+ */
+
+// Include necessary libraries and header files
+#include <stdio.h>
+#include <unistd.h>
+#include "output.h"
+#include "project.h"
+
+static char outputBuffer[OUTPUTSIZE]; /**< The characters not yet written. */
+static int outputUsed = 0; /**< The number of characters in the buffer. */
+static int outputInteractive = FALSE; /**< If stdout is a terminal. */
+static void (*beforeFlush)() = NULL; /**< Called before each flush. */
+
+void initOutput(){
+    outputInteractive = isatty(STDOUT_FILENO);
+}
+
+int isOutputInteractive(){
+    return outputInteractive;
+}
+
+void setBeforeFlush(void (*function)()){
+    beforeFlush = function;
+}
+
+void flushOutput(){
+    if (beforeFlush != NULL) beforeFlush();
+    if (outputUsed > 0)
+        fwrite(outputBuffer, sizeof(char), outputUsed, stdout);
+    outputUsed = 0;
+    fflush(stdout);
+}
+
+/**
+ * @brief Makes sure the output buffer has room for some characters.
+ * @param size The number of characters that will be written.
+ */
+static void reserveOutput(int size){
+    if (outputUsed + size > OUTPUTSIZE) flushOutput();
+}
+
+void writeChar(char letter){
+    reserveOutput(1);
+    outputBuffer[outputUsed++] = letter;
+}
+
+void writeString(char *text){
+    while (*text != '\0'){
+        if (outputUsed == OUTPUTSIZE) flushOutput();
+        outputBuffer[outputUsed++] = *text++;
+    }
+}
+
+void writeError(char *subject, char *error){
+    writeString(subject);
+    writeString(": ");
+    writeString(error);
+    writeString(".\n");
+}
+
+void writePaddedNumber(int number, int width){
+    char digits[MAXNUMBERSIZE];
+    int count = 0;
+    unsigned int value = number;
+
+    reserveOutput(MAXNUMBERSIZE + width);
+    if (number < 0){
+        outputBuffer[outputUsed++] = '-';
+        value = -value;
+    }
+
+    do{ // digits are found from the least significant one
+        digits[count++] = '0' + value % 10;
+        value /= 10;
+    }while (value > 0);
+
+    for (; width > count; width--) outputBuffer[outputUsed++] = '0';
+    while (count > 0) outputBuffer[outputUsed++] = digits[--count];
+}
+
+void writeNumber(int number){
+    writePaddedNumber(number, 0);
+}
+
+void writeLong(long number){
+    char digits[MAXNUMBERSIZE];
+    int count = 0;
+    unsigned long value = number;
+
+    reserveOutput(MAXNUMBERSIZE);
+    if (number < 0){
+        outputBuffer[outputUsed++] = '-';
+        value = -value;
+    }
+
+    do{ // digits are found from the least significant one
+        digits[count++] = '0' + value % 10;
+        value /= 10;
+    }while (value > 0);
+
+    while (count > 0) outputBuffer[outputUsed++] = digits[--count];
+}
+
+void writeMoney(cents money){
+    char digits[MAXMONEYSIZE];
+    int count = 0;
+
+    reserveOutput(MAXMONEYSIZE + 1);
+    if (money < 0){
+        outputBuffer[outputUsed++] = '-';
+        money = -money;
+    }
+
+    do{ // digits are found from the least significant one
+        digits[count++] = '0' + money % 10;
+        money /= 10;
+        if (count == 2) digits[count++] = '.';
+    }while (money > 0 || count < 4);
+
+    while (count > 0) outputBuffer[outputUsed++] = digits[--count];
+}
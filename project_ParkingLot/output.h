@@ -0,0 +1,88 @@
+/**
+ * @file output.h
+ * @brief This header file contains the declarations of the buffered output
+ * functions.
+ */
+
+// Check if the header file has already been included
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+// Include header file
+#include "dateAndHour.h"
+
+#define OUTPUTSIZE 65536 /**< The size of the output buffer. */
+#define MAXNUMBERSIZE 32 /**< Maximum characters written for a number. */
+#define MAXMONEYSIZE 32 /**< Maximum characters written for an amount. */
+
+/**
+ * @brief Prepares the output buffer.
+ * This function checks if the standard output is a terminal, in that case
+ * the buffer is flushed after every command so the user sees the answers.
+ */
+void initOutput();
+
+/**
+ * @brief Checks if the output is flushed after every command.
+ * @return int: TRUE if the standard output is a terminal, FALSE otherwise.
+ */
+int isOutputInteractive();
+
+/**
+ * @brief Writes a string to the output buffer.
+ * @param text The string to write.
+ */
+void writeString(char *text);
+
+/**
+ * @brief Writes a character to the output buffer.
+ * @param letter The character to write.
+ */
+void writeChar(char letter);
+
+/**
+ * @brief Writes an error message about something to the output buffer.
+ * The message is written as "<subject>: <error>." followed by a newline.
+ * @param subject What the error is about, a park name or a licence plate.
+ * @param error The description of the error.
+ */
+void writeError(char *subject, char *error);
+
+/**
+ * @brief Writes an integer to the output buffer, like "%d".
+ * @param number The integer to write.
+ */
+void writeNumber(int number);
+
+/**
+ * @brief Writes an integer padded with zeros, like "%0Nd".
+ * @param number The integer to write.
+ * @param width The minimum number of digits written.
+ */
+void writePaddedNumber(int number, int width);
+
+/**
+ * @brief Writes a long integer to the output buffer, like "%ld".
+ * @param number The long integer to write.
+ */
+void writeLong(long number);
+
+/**
+ * @brief Writes an amount of money with two decimals, like "%.2lf".
+ * @param money The amount to write, in cents.
+ */
+void writeMoney(cents money);
+
+/**
+ * @brief Sets a function called before the output buffer is written.
+ * @param function The function, or NULL for none.
+ */
+void setBeforeFlush(void (*function)());
+
+/**
+ * @brief Writes the contents of the output buffer to the standard output,
+ * after calling the function set with setBeforeFlush.
+ */
+void flushOutput();
+
+#endif
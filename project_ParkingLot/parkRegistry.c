@@ -0,0 +1,331 @@
+/**
+ * @file parkRegistry.c
+ * @brief This file contains the implementation of the registry of all parks.
+ */
+
+// Include necessary libraries and header file
+#include <stdlib.h>
+#include <string.h>
+#include "parkRegistry.h"
+
+unsigned int hashFuncPW(char *strToHash){
+    char *letter;
+    unsigned int hashVal, tempVal;
+
+    hashVal = 0;
+    for(letter = strToHash; *letter!='\0'; letter++){
+        hashVal = (hashVal << 4) + *letter;
+        // shift the hash value 4 bits to the left.
+
+        // If the most significant 4 bits of hashVal are not 0
+        if ((tempVal = hashVal) & 0xF0000000){
+            // XOR those bits into the least significant 4 bits of hashVal.
+            hashVal ^= tempVal >>24;
+            hashVal ^= tempVal;
+            }
+    }
+    if (hashVal <= DELETEDKEY) hashVal += DELETEDKEY + 1; // reserved keys
+    return hashVal;
+}
+
+/**
+ * @brief Gets the first slot to probe for a key.
+ * The key is spread with Fibonacci hashing, so the index uses all its bits.
+ * @param key The key of the slot.
+ * @param bits The base 2 logarithm of the number of slots.
+ * @return unsigned int: The index of the slot.
+ */
+static unsigned int parkSlotIndex(unsigned int key, unsigned int bits){
+    return (key * 2654435769u) >> (32 - bits);
+}
+
+/**
+ * @brief Searches for the slot of a park in the names index.
+ * @param allParks A pointer to the parkRegistry structure.
+ * @param parkName The name of the park.
+ * @return parkSlot*: The slot with the park, NULL if not found.
+ */
+static parkSlot *findParkSlot(parkRegistry *allParks, char *parkName){
+    unsigned int key = hashFuncPW(parkName);
+    unsigned int index = parkSlotIndex(key, allParks->bits);
+    parkSlot *slot;
+
+    // stop at the first empty slot, deleted slots are skipped
+    while ((slot = &allParks->table[index])->item != NULL || slot->key != 0){
+        if (slot->item != NULL && slot->key == key &&
+            strcmp(getParkName(getParkInfo(slot->item)), parkName) == 0)
+                return slot;
+
+        index = (index + 1) & (allParks->size - 1);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Puts the item of a park in the first free slot for its key.
+ * @param allParks A pointer to the parkRegistry structure.
+ * @param key The hash of the park's name.
+ * @param item The item of the park in the list of parks.
+ */
+static void placePark(parkRegistry *allParks, unsigned int key, info *item){
+    unsigned int index = parkSlotIndex(key, allParks->bits);
+
+    while (allParks->table[index].item != NULL)
+        index = (index + 1) & (allParks->size - 1);
+
+    if (allParks->table[index].key == 0) allParks->used++;
+    allParks->table[index].key = key;
+    allParks->table[index].item = item;
+}
+
+/**
+ * @brief Rebuilds the names index without its deleted slots.
+ * The index doubles its size if more than a quarter of the slots have parks.
+ * Parks are only created by the p command, so the whole index is rebuilt at
+ * once.
+ * @param allParks A pointer to the parkRegistry structure.
+ */
+static void growParkIndex(parkRegistry *allParks){
+    parkSlot *oldTable = allParks->table;
+    unsigned int oldSize = allParks->size, ind;
+
+    if ((unsigned int) getRegistryCount(allParks) * 4 > allParks->size){
+        allParks->size *= 2;
+        allParks->bits++;
+    }
+    allParks->table = (parkSlot*) calloc(allParks->size, sizeof(parkSlot));
+    allParks->used = 0;
+
+    for (ind = 0; ind < oldSize; ind++)
+        if (oldTable[ind].item != NULL)
+            placePark(allParks, oldTable[ind].key, oldTable[ind].item);
+
+    free(oldTable);
+}
+
+/**
+ * @brief Draws the number of levels of a new node of the order.
+ * Each level is kept with a probability of 1/4, using a xorshift generator
+ * so the order doesn't depend on the state of rand.
+ * @param allParks A pointer to the parkRegistry structure.
+ * @return int: The number of levels, from 1 to MAXORDERLEVELS.
+ */
+static int randomOrderLevels(parkRegistry *allParks){
+    unsigned int seed = allParks->orderSeed;
+    int levels = 1;
+
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    allParks->orderSeed = seed;
+
+    for (; levels < MAXORDERLEVELS && (seed & 3) == 0; seed >>= 2)
+        levels++;
+    return levels;
+}
+
+/**
+ * @brief Finds the last node before a name on each level of the order.
+ * @param allParks A pointer to the parkRegistry structure.
+ * @param parkName The name to search for.
+ * @param before Where the last node before the name is stored for each level.
+ */
+static void findOrderPosition(parkRegistry *allParks, char *parkName,
+    parkOrderNode **before){
+
+    parkOrderNode *node = allParks->orderHead;
+    int level;
+
+    for (level = allParks->orderLevels - 1; level >= 0; level--){
+        while (node->next[level] != NULL &&
+            strcmp(getParkName(node->next[level]->park), parkName) < 0)
+                node = node->next[level];
+
+        before[level] = node;
+    }
+}
+
+/**
+ * @brief Adds a park to the alphabetical order.
+ * @param allParks A pointer to the parkRegistry structure.
+ * @param park A pointer to the park to add.
+ */
+static void addParkInOrder(parkRegistry *allParks, parkingLot *park){
+    parkOrderNode *before[MAXORDERLEVELS], *newNode;
+    int levels = randomOrderLevels(allParks), level;
+
+    findOrderPosition(allParks, getParkName(park), before);
+    for (; allParks->orderLevels < levels; allParks->orderLevels++)
+        before[allParks->orderLevels] = allParks->orderHead;
+
+    newNode = (parkOrderNode*) malloc(sizeof(parkOrderNode) +
+        sizeof(parkOrderNode*) * levels);
+    newNode->park = park;
+    for (level = 0; level < levels; level++){
+        newNode->next[level] = before[level]->next[level];
+        before[level]->next[level] = newNode;
+    }
+}
+
+/**
+ * @brief Removes a park from the alphabetical order.
+ * @param allParks A pointer to the parkRegistry structure.
+ * @param park A pointer to the park to remove.
+ */
+static void removeParkFromOrder(parkRegistry *allParks, parkingLot *park){
+    parkOrderNode *before[MAXORDERLEVELS], *oldNode;
+    int level;
+
+    findOrderPosition(allParks, getParkName(park), before);
+    oldNode = before[0]->next[0];
+
+    for (level = 0; level < allParks->orderLevels &&
+        before[level]->next[level] == oldNode; level++)
+            before[level]->next[level] = oldNode->next[level];
+
+    while (allParks->orderLevels > 1 &&
+        allParks->orderHead->next[allParks->orderLevels - 1] == NULL)
+            allParks->orderLevels--;
+    free(oldNode);
+}
+
+parkRegistry *createParkRegistry(){
+    parkRegistry *allParks = (parkRegistry*) malloc(sizeof(parkRegistry));
+
+    allParks->parks = createList();
+    allParks->size = INITIALPARKSLOTS;
+    for (allParks->bits = 0; (1u << allParks->bits) < INITIALPARKSLOTS;
+        allParks->bits++);
+
+    allParks->table = (parkSlot*) calloc(allParks->size, sizeof(parkSlot));
+    allParks->used = 0;
+
+    allParks->orderHead = (parkOrderNode*) calloc(1, sizeof(parkOrderNode) +
+        sizeof(parkOrderNode*) * MAXORDERLEVELS);
+    allParks->orderLevels = 1;
+    allParks->orderSeed = 2463534242u; // any seed but 0
+    allParks->created = 0;
+    allParks->numbered = NULL;
+    allParks->numberedSize = 0;
+    return allParks;
+}
+
+list *getRegistryParks(parkRegistry *allParks){
+    return allParks->parks;
+}
+
+int getRegistryCount(parkRegistry *allParks){
+    return getListSize(getRegistryParks(allParks));
+}
+
+parkOrderNode *getFirstParkInOrder(parkRegistry *allParks){
+    return allParks->orderHead->next[0];
+}
+
+parkOrderNode *getNextParkInOrder(parkOrderNode *node){
+    return node->next[0];
+}
+
+parkingLot *getOrderedPark(parkOrderNode *node){
+    return node->park;
+}
+
+/**
+ * @brief Keeps a park in the array of parks by number, growing it to fit.
+ * @param allParks A pointer to the parkRegistry structure.
+ * @param park A pointer to the park, with its number.
+ */
+static void placeParkNumber(parkRegistry *allParks, parkingLot *park){
+    unsigned int number = getParkNumber(park), oldSize;
+
+    if (number >= allParks->numberedSize){
+        oldSize = allParks->numberedSize;
+        if (allParks->numberedSize == 0)
+            allParks->numberedSize = INITIALPARKSLOTS;
+        while (number >= allParks->numberedSize)
+            allParks->numberedSize *= 2;
+        allParks->numbered = (parkingLot**) realloc(allParks->numbered,
+            sizeof(parkingLot*) * allParks->numberedSize);
+        memset(allParks->numbered + oldSize, 0,
+            sizeof(parkingLot*) * (allParks->numberedSize - oldSize));
+    }
+    allParks->numbered[number] = park;
+}
+
+/**
+ * @brief Adds a park with its number to the list, the indexes and the order
+ * of a registry.
+ * @param allParks A pointer to the parkRegistry structure.
+ * @param park A pointer to the park to add.
+ */
+static void insertPark(parkRegistry *allParks, parkingLot *park){
+    info *parkItem = createInfo(park, ISPARKINGLOT);
+
+    if ((unsigned int) (allParks->used + 1) * 2 > allParks->size)
+        growParkIndex(allParks);
+
+    addItem(getRegistryParks(allParks), parkItem);
+    placePark(allParks, hashFuncPW(getParkName(park)), parkItem);
+    placeParkNumber(allParks, park);
+    addParkInOrder(allParks, park);
+}
+
+void addPark(parkRegistry *allParks, parkingLot *park){
+    changeParkNumber(park, allParks->created++);
+    insertPark(allParks, park);
+}
+
+void restorePark(parkRegistry *allParks, parkingLot *park,
+    unsigned int number){
+
+    changeParkNumber(park, number);
+    insertPark(allParks, park);
+}
+
+unsigned int getRegistryCreated(parkRegistry *allParks){
+    return allParks->created;
+}
+
+void changeRegistryCreated(parkRegistry *allParks, unsigned int created){
+    allParks->created = created;
+}
+
+parkingLot *searchPark(parkRegistry *allParks, char *parkName){
+    parkSlot *slot = findParkSlot(allParks, parkName);
+
+    if (slot == NULL) return NULL;
+    return getParkInfo(slot->item);
+}
+
+parkingLot *searchParkByNumber(parkRegistry *allParks, unsigned int number){
+    if (number >= allParks->numberedSize) return NULL;
+    return allParks->numbered[number];
+}
+
+parkingLot *popPark(parkRegistry *allParks, char *parkName){
+    parkSlot *slot = findParkSlot(allParks, parkName);
+    parkingLot *park;
+
+    if (slot == NULL) return NULL; // If the park is not in the registry
+    park = getParkInfo(slot->item);
+    freeInfoItem(unlinkItem(getRegistryParks(allParks), slot->item));
+    slot->item = NULL;
+    slot->key = DELETEDKEY;
+    allParks->numbered[getParkNumber(park)] = NULL;
+    removeParkFromOrder(allParks, park);
+    return park;
+}
+
+void freeParkRegistry(parkRegistry *allParks){
+    parkOrderNode *node = allParks->orderHead, *nextNode;
+
+    while (node != NULL){ // the head and the node of each park
+        nextNode = node->next[0];
+        free(node);
+        node = nextNode;
+    }
+    freeList(getRegistryParks(allParks));
+    free(allParks->table);
+    free(allParks->numbered);
+    free(allParks);
+}
@@ -0,0 +1,193 @@
+/**
+ * @file parkRegistry.h
+ * @brief This header file contains the declarations of the parkRegistry
+ * structure and related functions.
+ */
+
+// Check if the header file has already been included
+#ifndef PARKREGISTRY_H
+#define PARKREGISTRY_H
+
+// Include header file
+#include "project.h"
+
+#define INITIALPARKSLOTS 64 /**< The initial number of slots, a power of 2 */
+#define MAXORDERLEVELS 16 /**< The maximum number of levels of the order */
+
+// Forward declaration of structures
+typedef struct list list;
+typedef struct info info;
+typedef struct parkingLot parkingLot;
+
+/**
+ * @struct parkSlot
+ * @brief A structure to represent a slot of the park names index.
+ * A slot with an item is in use. A slot without an item is empty if its key
+ * is 0, or deleted if its key is DELETEDKEY, searches don't stop on deleted
+ * slots.
+ */
+typedef struct parkSlot{
+    unsigned int key; /**< The hash of the park's name. */
+    info *item; /**< The item of the park in the list of parks. */
+}parkSlot;
+
+/**
+ * @struct parkOrderNode
+ * @brief A structure to represent a park in the alphabetical order of parks.
+ * The order is a skip list, each node has a random number of levels and a
+ * link to the next node of each level. The first level links all the parks.
+ */
+typedef struct parkOrderNode{
+    parkingLot *park; /**< The park of the node. */
+    struct parkOrderNode *next[]; /**< The next node of each level. */
+}parkOrderNode;
+
+/**
+ * @struct parkRegistry
+ * @brief A structure to represent all the parks of the system. This structure
+ * keeps the parks in a list by order of creation, an open addressing index of
+ * their names, with linear probing, so a park is found without going through
+ * the list, a skip list with the parks in alphabetical order, and an array
+ * of the parks by number.
+ */
+typedef struct parkRegistry{
+    list *parks; /**< The list of parks by order of creation. */
+    parkSlot *table; /**< The array of slots of the names index. */
+    unsigned int size; /**< The number of slots, a power of 2. */
+    unsigned int bits; /**< The base 2 logarithm of the size. */
+    int used; /**< The count of slots in use or deleted. */
+    parkOrderNode *orderHead; /**< The head of the alphabetical order, with
+        MAXORDERLEVELS levels and no park. */
+    int orderLevels; /**< The number of levels in use in the order. */
+    unsigned int orderSeed; /**< The state used to draw the levels. */
+    unsigned int created; /**< The count of parks ever added, the number of
+        the next park. */
+    parkingLot **numbered; /**< The parks by number, NULL for removed ones. */
+    unsigned int numberedSize; /**< The number of parks that fit in it. */
+}parkRegistry;
+
+/**
+ * @brief Hash function based on Peter Weinberger's method.
+ * This function calculates the hash value of a string using Peter Weinberger's
+ * method. The value is never 0 or DELETEDKEY, so it can be kept as the key of
+ * a slot.
+ * @param strToHash The string to hash.
+ * @return unsigned int: The hash value.
+ */
+unsigned int hashFuncPW(char *strToHash);
+
+/**
+ * @brief Creates a new parkRegistry structure.
+ * This function allocates memory for a new registry without parks, with an
+ * empty list and INITIALPARKSLOTS empty slots.
+ * @return parkRegistry*: A pointer to the created parkRegistry structure.
+ */
+parkRegistry *createParkRegistry();
+
+/**
+ * @brief Gets the list of parks by order of creation.
+ * @param allParks A pointer to the parkRegistry structure.
+ * @return list*: The list of parks.
+ */
+list *getRegistryParks(parkRegistry *allParks);
+
+/**
+ * @brief Gets the number of parks in the registry.
+ * @param allParks A pointer to the parkRegistry structure.
+ * @return int: The number of parks.
+ */
+int getRegistryCount(parkRegistry *allParks);
+
+/**
+ * @brief Gets the first park in alphabetical order.
+ * @param allParks A pointer to the parkRegistry structure.
+ * @return parkOrderNode*: The node of the first park, NULL if there are none.
+ */
+parkOrderNode *getFirstParkInOrder(parkRegistry *allParks);
+
+/**
+ * @brief Gets the next park in alphabetical order.
+ * @param node The node of the current park.
+ * @return parkOrderNode*: The node of the next park, NULL if it was the last.
+ */
+parkOrderNode *getNextParkInOrder(parkOrderNode *node);
+
+/**
+ * @brief Gets the park of a node of the alphabetical order.
+ * @param node The node.
+ * @return parkingLot*: The park of the node.
+ */
+parkingLot *getOrderedPark(parkOrderNode *node);
+
+/**
+ * @brief Adds a park to the registry.
+ * The park is added to the end of the list of parks, to the names index and
+ * to the alphabetical order, and gets the next number.
+ * There must not be a park with the same name in the registry.
+ * @param allParks A pointer to the parkRegistry structure.
+ * @param park A pointer to the park to add.
+ */
+void addPark(parkRegistry *allParks, parkingLot *park);
+
+/**
+ * @brief Adds a saved park to the registry, with its number.
+ * The park is added like with addPark, without changing the count of parks
+ * ever added, which is restored with changeRegistryCreated.
+ * @param allParks A pointer to the parkRegistry structure.
+ * @param park A pointer to the park to add.
+ * @param number The number of the park.
+ */
+void restorePark(parkRegistry *allParks, parkingLot *park,
+    unsigned int number);
+
+/**
+ * @brief Gets the count of parks ever added to the registry.
+ * @param allParks A pointer to the parkRegistry structure.
+ * @return unsigned int: The number the next park will get.
+ */
+unsigned int getRegistryCreated(parkRegistry *allParks);
+
+/**
+ * @brief Changes the count of parks ever added to the registry.
+ * It is used when saved parks are restored with their numbers.
+ * @param allParks A pointer to the parkRegistry structure.
+ * @param created The number the next park will get.
+ */
+void changeRegistryCreated(parkRegistry *allParks, unsigned int created);
+
+/**
+ * @brief Searches for a park by its name.
+ * @param allParks A pointer to the parkRegistry structure.
+ * @param parkName The name of the park.
+ * @return parkingLot*: The park found, or NULL if not found.
+ */
+parkingLot *searchPark(parkRegistry *allParks, char *parkName);
+
+/**
+ * @brief Searches for a park by its number.
+ * Numbers are not given again, so a removed park is never mistaken for
+ * another.
+ * @param allParks A pointer to the parkRegistry structure.
+ * @param number The number of the park.
+ * @return parkingLot*: The park found, or NULL if it was removed or never
+ * existed.
+ */
+parkingLot *searchParkByNumber(parkRegistry *allParks, unsigned int number);
+
+/**
+ * @brief Pops a park from the registry.
+ * This function removes the park from the list of parks, from the names
+ * index and from the alphabetical order. The park itself is not freed.
+ * @param allParks A pointer to the parkRegistry structure.
+ * @param parkName The name of the park.
+ * @return parkingLot*: The poped park, or NULL if not found.
+ */
+parkingLot *popPark(parkRegistry *allParks, char *parkName);
+
+/**
+ * @brief Frees the registry and all its parks.
+ * @param allParks A pointer to the parkRegistry structure.
+ */
+void freeParkRegistry(parkRegistry *allParks);
+
+#endif
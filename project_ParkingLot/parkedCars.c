@@ -5,47 +5,158 @@
  * @date 29/03/2024
  */
 
-// Include necessary library and header file
+// Include necessary libraries and header file
 #include <stdlib.h>
+#include <string.h>
 #include "parkedCars.h"
 
-parkedCars *createParkedCars(date *logDate){
-    parkedCars *newPrkdCars = (parkedCars*) malloc(sizeof(parkedCars));
-    newPrkdCars->parkedCars = createList();
+/**
+ * @brief Creates a new parkedCars structure with room for a number of exits.
+ * @param arena The arena of the parking lot.
+ * @param logDate The date of parking.
+ * @param exitSize The number of exits that fit in the array.
+ * @return parkedCars*: A pointer to the created parkedCars structure.
+ */
+static parkedCars *newParkedCars(memoryArena *arena, date logDate,
+    int exitSize){
+
+    parkedCars *newPrkdCars =
+        (parkedCars*) arenaAllocate(arena, sizeof(parkedCars));
+    newPrkdCars->arena = arena;
+    newPrkdCars->exits = (exitVehicle*) arenaAllocate(arena,
+        sizeof(exitVehicle) * exitSize);
+    newPrkdCars->exitCount = 0;
+    newPrkdCars->exitSize = exitSize;
     newPrkdCars->earnedFee = 0;
     newPrkdCars->parkingDate = logDate;
     return newPrkdCars;
 }
 
-date *getParkedCarsDate(parkedCars *parkedCars){
+parkedCars *createParkedCars(memoryArena *arena, date logDate){
+    return newParkedCars(arena, logDate, INITIALDAYEXITS);
+}
+
+date getParkedCarsDate(parkedCars *parkedCars){
     return parkedCars->parkingDate;
 }
 
-double getParkedCarsEarnedFee(parkedCars *parkedCars){
+cents getParkedCarsEarnedFee(parkedCars *parkedCars){
     return parkedCars->earnedFee;
 }
 
-list *getParkedCarsList(parkedCars *parkedCars){
-    return parkedCars->parkedCars;
+int getParkedCarsCount(parkedCars *parkedCars){
+    return parkedCars->exitCount;
+}
+
+exitVehicle *getParkedCarsExit(parkedCars *parkedCars, int position){
+    return &parkedCars->exits[position];
 }
 
-void addToEarnedFee(parkedCars *parkedCars, double fee){
+void addExitToParkedCars(parkedCars *parkedCars, plate carPlate,
+    hours logHours, cents fee){
+
+    exitVehicle *carExit;
+
+    if (parkedCars->exitCount == parkedCars->exitSize){ // the array is full
+        parkedCars->exits = (exitVehicle*) arenaGrow(parkedCars->arena,
+            parkedCars->exits, sizeof(exitVehicle) * parkedCars->exitSize,
+            sizeof(exitVehicle) * parkedCars->exitSize * 2);
+        parkedCars->exitSize *= 2;
+    }
+    carExit = &parkedCars->exits[parkedCars->exitCount++];
+    carExit->registration = carPlate;
+    carExit->exitHours = logHours;
+    carExit->payment = fee;
     parkedCars->earnedFee += fee;
 }
 
-parkedCars *searchForParkedCars(list *listPrkdCars, date *logDate){
-    info *prkdCarsSect = getLastItem(listPrkdCars);
-    // Iterate over the list until a parked cars section with the same
-    //date is found or the list ends
-    while (prkdCarsSect != NULL && !isSameDate(logDate,
-        getParkedCarsDate(getParkedCarsInfo(prkdCarsSect))))
-            prkdCarsSect = getPreviousItem(prkdCarsSect);
+parkedCars *restoreParkedCars(memoryArena *arena, date logDate,
+    exitVehicle *exits, int count){
+
+    parkedCars *newPrkdCars;
+    int exit, exitSize = INITIALDAYEXITS;
+
+    for (; exitSize < count; exitSize *= 2); // as adding them would grow it
+    newPrkdCars = newParkedCars(arena, logDate, exitSize);
+
+    memcpy(newPrkdCars->exits, exits, sizeof(exitVehicle) * count);
+    newPrkdCars->exitCount = count;
+    for (exit = 0; exit < count; exit++)
+        newPrkdCars->earnedFee += newPrkdCars->exits[exit].payment;
+    return newPrkdCars;
+}
+
+parkedCarsCalendar *createParkedCarsCalendar(){
+    parkedCarsCalendar *calendar =
+        (parkedCarsCalendar*) malloc(sizeof(parkedCarsCalendar));
+
+    calendar->years = NULL;
+    calendar->firstYear = 0;
+    calendar->yearCount = 0;
+    return calendar;
+}
+
+parkedCars *searchInCalendar(parkedCarsCalendar *calendar, date logDate){
+    int year = getDateYear(logDate) - calendar->firstYear;
+
+    if (year < 0 || year >= calendar->yearCount ||
+        calendar->years[year] == NULL)
+            return NULL;
+
+    return calendar->years[year][getDateDayOfYear(logDate)];
+}
+
+/**
+ * @brief Makes the calendar include a year.
+ * Years after the calendar at least double the number of blocks, as exits
+ * come in chronological order and the calendar keeps growing at its end.
+ * @param calendar A pointer to the parkedCarsCalendar structure.
+ * @param year The year to include.
+ */
+static void growCalendar(parkedCarsCalendar *calendar, int year){
+    int newFirst = calendar->firstYear, newCount, shift;
+    parkedCars ***newYears;
+
+    if (calendar->yearCount == 0 || year < newFirst) newFirst = year;
+    newCount = calendar->firstYear + calendar->yearCount - newFirst;
+    if (year - newFirst >= newCount){
+        newCount *= 2;
+        if (year - newFirst >= newCount) newCount = year - newFirst + 1;
+    }
+
+    newYears = (parkedCars***) calloc(newCount, sizeof(parkedCars**));
+    shift = calendar->firstYear - newFirst;
+    if (calendar->yearCount > 0)
+        memcpy(newYears + shift, calendar->years,
+            sizeof(parkedCars**) * calendar->yearCount);
+
+    free(calendar->years);
+    calendar->years = newYears;
+    calendar->firstYear = newFirst;
+    calendar->yearCount = newCount;
+}
+
+void addToCalendar(parkedCarsCalendar *calendar, parkedCars *prkdCarsSect){
+    date logDate = getParkedCarsDate(prkdCarsSect);
+    int year = getDateYear(logDate);
+
+    if (calendar->yearCount == 0 || year < calendar->firstYear ||
+        year >= calendar->firstYear + calendar->yearCount)
+            growCalendar(calendar, year);
 
-    return getParkedCarsInfo(prkdCarsSect);
+    year -= calendar->firstYear;
+    if (calendar->years[year] == NULL)
+        calendar->years[year] =
+            (parkedCars**) calloc(DAYSINYEAR, sizeof(parkedCars*));
+
+    calendar->years[year][getDateDayOfYear(logDate)] = prkdCarsSect;
 }
 
-void freeParkedCars(parkedCars *parkedCars){
-    shallowFreeList(getParkedCarsList(parkedCars)); // Parked cars info that day
-    freeDate(getParkedCarsDate(parkedCars));
-    free(parkedCars);
+void freeParkedCarsCalendar(parkedCarsCalendar *calendar){
+    int year;
+
+    for (year = 0; year < calendar->yearCount; year++)
+        free(calendar->years[year]);
+    free(calendar->years);
+    free(calendar);
 }
@@ -13,76 +13,137 @@
 // Include header file
 #include "project.h"
 
+#define INITIALDAYEXITS 4 /**< The initial number of exits of a day. */
+
 // Forward declaration of structures
 typedef struct list list;
-typedef struct date date;
 typedef struct entryAndExit entryAndExit;
+typedef struct exitVehicle exitVehicle;
 
 /**
  * @struct parkedCars
  * @brief A structure to represent a record of cars parked on a specific date.
  * This structure represents a record of cars parked on a specific date with
- * the total fee earned.
+ * the total fee earned. The exits of the day are kept by order of exit in an
+ * array that doubles its size when full. The record belongs to the arena of
+ * the park, so it is freed with the park.
  */
 typedef struct parkedCars{
-    struct date *parkingDate; /**< The date of parking. */
-    double earnedFee; /**< The total fee earned from the parked cars. */
-    struct list *parkedCars; /**< A list of the cars parked on this date. */
+    date parkingDate; /**< The date of parking. */
+    cents earnedFee; /**< The total fee earned from the parked cars. */
+    memoryArena *arena; /**< The arena of the park. */
+    exitVehicle *exits; /**< The exits of this date. */
+    int exitCount; /**< The number of exits of this date. */
+    int exitSize; /**< The number of exits that fit in the array. */
 } parkedCars;
 
+/**
+ * @struct parkedCarsCalendar
+ * @brief A structure to find the parkedCars of a park by their date. The
+ * calendar has a block with a slot for each day of a year, for every year
+ * from the first year with exits. Blocks are only created for years with
+ * exits, so a date is found with two array accesses.
+ */
+typedef struct parkedCarsCalendar{
+    parkedCars ***years; /**< The block of each year, NULL if it has no
+        exits. */
+    int firstYear; /**< The year of the first block. */
+    int yearCount; /**< The number of blocks. */
+} parkedCarsCalendar;
+
 /**
  * @brief Creates a new parkedCars structure.
- * This function allocates memory for a new parkedCars structure and initializes
- * it with the given parameters. It also creates a list for the cars currently
- * parked and sets the earned fee to 0.
+ * This function takes a new parkedCars structure from the arena of the park
+ * and initializes it with the given parameters. It also creates an array for
+ * the exits of the day and sets the earned fee to 0.
+ * @param arena The arena of the parking lot.
  * @param logDate The date of parking.
  * @return parkedCars*: A pointer to the created parkedCars structure.
  */
-parkedCars *createParkedCars(date *logDate);
+parkedCars *createParkedCars(memoryArena *arena, date logDate);
 
 /**
  * @brief Gets the parking date from a parkedCars structure.
  * @param parkedCars A pointer to the parkedCars structure.
- * @return date*: The parking date.
+ * @return date: The parking date.
  */
-date *getParkedCarsDate(parkedCars *parkedCars);
+date getParkedCarsDate(parkedCars *parkedCars);
 
 /**
  * @brief Gets the earned fee from a parkedCars structure.
  * @param parkedCars A pointer to the parkedCars structure.
- * @return double: The earned fee.
+ * @return cents: The earned fee.
+ */
+cents getParkedCarsEarnedFee(parkedCars *parkedCars);
+
+/**
+ * @brief Gets the number of exits of a parkedCars structure.
+ * @param parkedCars A pointer to the parkedCars structure.
+ * @return int: The number of exits.
  */
-double getParkedCarsEarnedFee(parkedCars *parkedCars);
+int getParkedCarsCount(parkedCars *parkedCars);
 
 /**
- * @brief Gets the list of parked cars from a parkedCars structure.
+ * @brief Gets an exit of a parkedCars structure.
  * @param parkedCars A pointer to the parkedCars structure.
- * @return list*: A pointer to the list of parked cars.
+ * @param position The position of the exit, from 0, by order of exit.
+ * @return exitVehicle*: A pointer to the exit.
  */
-list *getParkedCarsList(parkedCars *parkedCars);
+exitVehicle *getParkedCarsExit(parkedCars *parkedCars, int position);
 
 /**
- * @brief Adds a fee to the total earned fee of a parkedCars structure.
+ * @brief Adds an exit to a parkedCars structure.
+ * The exit is stored after the previous ones and its fee is added to the
+ * total earned fee.
  * @param parkedCars A pointer to the parkedCars structure.
- * @param fee The fee to be added.
+ * @param carPlate The registration of the vehicle.
+ * @param logHours The time of vehicle exit.
+ * @param fee The fee paid.
  */
-void addToEarnedFee(parkedCars *parkedCars, double fee);
+void addExitToParkedCars(parkedCars *parkedCars, plate carPlate,
+    hours logHours, cents fee);
 
 /**
- * @brief Searches for a parkedCars structure in a list by a given date.
- * Iterates over the list of parkedCars structures to find a match
- * with the given date.
- * @param listPrkdCars A pointer to the list of parkedCars structures.
+ * @brief Creates a parkedCars structure with the exits of a saved day.
+ * The exits are copied in one block to an array of the arena of the park,
+ * with the size it would have after adding them one by one.
+ * @param arena The arena of the parking lot.
+ * @param logDate The date of parking.
+ * @param exits The exits of the day, by order of exit.
+ * @param count The number of exits.
+ * @return parkedCars*: A pointer to the created parkedCars structure.
+ */
+parkedCars *restoreParkedCars(memoryArena *arena, date logDate,
+    exitVehicle *exits, int count);
+
+/**
+ * @brief Creates a new parkedCarsCalendar structure without years.
+ * @return parkedCarsCalendar*: A pointer to the created calendar.
+ */
+parkedCarsCalendar *createParkedCarsCalendar();
+
+/**
+ * @brief Searches for the parkedCars structure of a date in a calendar.
+ * @param calendar A pointer to the parkedCarsCalendar structure.
  * @param logDate The date to search for.
- * @return parkedCars*: A pointer to the matching parkedCars structure,
+ * @return parkedCars*: A pointer to the parkedCars structure of the date,
  * or NULL if not found.
  */
-parkedCars *searchForParkedCars(list *listPrkdCars, date *logDate);
+parkedCars *searchInCalendar(parkedCarsCalendar *calendar, date logDate);
+
+/**
+ * @brief Adds a parkedCars structure to a calendar, in the slot of its date.
+ * The calendar grows to include the year of the date if needed.
+ * @param calendar A pointer to the parkedCarsCalendar structure.
+ * @param prkdCarsSect A pointer to the parkedCars structure to add.
+ */
+void addToCalendar(parkedCarsCalendar *calendar, parkedCars *prkdCarsSect);
 
 /**
- * @brief Frees the memory allocated for a parkedCars structure.
- * @param parkedCars A pointer to the parkedCars structure to be freed.
+ * @brief Frees the memory allocated for a parkedCarsCalendar structure.
+ * The parkedCars structures are not freed, they belong to the park history.
+ * @param calendar A pointer to the parkedCarsCalendar structure.
  */
-void freeParkedCars(parkedCars *parkedCars);
+void freeParkedCarsCalendar(parkedCarsCalendar *calendar);
 
 #endif
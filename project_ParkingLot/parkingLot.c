@@ -6,24 +6,37 @@
  */
 
 // Include necessaries library and header file
-#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "parkingLot.h"
+#include "output.h"
 
 parkingLot* createPark(char* parkName, int capacity,
-    double initialFee, double laterFee, double maxFee){
+    millicents initialFee, millicents laterFee, millicents maxFee){
 
     parkingLot *park = (parkingLot*) malloc(sizeof(parkingLot));
+    int quarters;
 
     park->name = (char*) malloc(sizeof(char)*strlen(parkName)+ 1);
     strcpy(park->name, parkName);
+    park->number = 0; // given by the registry
     park->capacity = capacity;
+    park->freeSpaces = capacity;
     park->initialFee = initialFee;
     park->laterFee = laterFee;
     park->maxFee = maxFee;
+    for (quarters = 0; quarters <= QUARTERSINDAY; quarters++)
+        park->dayFees[quarters] = dayPayment(quarters * MINUTESINQUARTER,
+            initialFee, laterFee, maxFee);
+
     park->carsIn = createList();
-    park->parkHistory = createList();
+    park->arena = createArena();
+    park->visitors = NULL;
+    park->visitorCount = 0;
+    park->visitorSize = 0;
+    park->evictedVisitors = 0;
+    park->historyDays = createParkedCarsCalendar();
+    park->income = createIncomeIndex();
     return park;
 }
 
@@ -31,6 +44,14 @@ char* getParkName( parkingLot *park){
     return park->name;
 }
 
+unsigned int getParkNumber(parkingLot *park){
+    return park->number;
+}
+
+void changeParkNumber(parkingLot *park, unsigned int number){
+    park->number = number;
+}
+
 list* getParkCarsIn(parkingLot *park){
     return park->carsIn;
 }
@@ -39,27 +60,100 @@ int getParkCapacity(parkingLot *park){
     return park->capacity;
 }
 
-double getParkInitialFee(parkingLot *park){
+millicents getParkInitialFee(parkingLot *park){
     return park->initialFee;
 }
 
-double getParkLaterFee(parkingLot *park){
+millicents getParkLaterFee(parkingLot *park){
     return park->laterFee;
 }
 
-double getParkMaxFee(parkingLot * park){
+millicents getParkMaxFee(parkingLot * park){
     return park->maxFee;
 }
 
-list* getParkHistory(parkingLot * park){
-    return park->parkHistory;
+memoryArena *getParkArena(parkingLot *park){
+    return park->arena;
+}
+
+incomeIndex *getParkIncome(parkingLot *park){
+    return park->income;
+}
+
+/**
+ * @brief Drops the visitors without a vehicle of a parkingLot structure.
+ * The other visitors are moved to the start of the array, and their sections
+ * get their new positions.
+ * @param park A pointer to the parkingLot structure.
+ */
+static void dropEvictedVisitors(parkingLot *park){
+    int visitor, kept = 0;
+
+    for (visitor = 0; visitor < park->visitorCount; visitor++)
+        if (park->visitors[visitor].car != NULL){
+            park->visitors[kept] = park->visitors[visitor];
+            changeCarHistoryVisitor(getCarHistoryInfo(
+                park->visitors[kept].historyItem), kept);
+            kept++;
+        }
+    park->visitorCount = kept;
+    park->evictedVisitors = 0;
+}
+
+void addParkVisitor(parkingLot *park, vehicle *car, info *historyItem){
+    int newSize;
+
+    if (park->visitorCount == park->visitorSize &&
+        park->evictedVisitors * 2 >= park->visitorCount &&
+        park->evictedVisitors > 0)
+            dropEvictedVisitors(park);
+
+    if (park->visitorCount == park->visitorSize){ // the array is full
+        newSize = park->visitorSize == 0 ? INITIALVISITORS :
+            park->visitorSize * 2;
+        park->visitors = (parkVisitor*) arenaGrow(park->arena,
+            park->visitors, sizeof(parkVisitor) * park->visitorSize,
+            sizeof(parkVisitor) * newSize);
+        park->visitorSize = newSize;
+    }
+    park->visitors[park->visitorCount].car = car;
+    park->visitors[park->visitorCount].historyItem = historyItem;
+    changeCarHistoryVisitor(getCarHistoryInfo(historyItem),
+        park->visitorCount);
+    park->visitorCount++;
+}
+
+void removeParkVisitor(parkingLot *park, int visitorIndex){
+    park->visitors[visitorIndex].car = NULL;
+    park->visitors[visitorIndex].historyItem = NULL;
+    park->evictedVisitors++;
 }
 
 int getParkFreeSpaces(parkingLot *park){
-    return getParkCapacity(park) - getListSize(getParkCarsIn(park));
+    return park->freeSpaces;
+}
+
+parkedCars *getParkHistoryDay(parkingLot *park, date logDate){
+    return searchInCalendar(park->historyDays, logDate);
 }
 
-int isInvalidFee(double initialFee, double laterFee, double maxFee){
+void restoreParkHistoryDay(parkingLot *park, parkedCars *day){
+    addToCalendar(park->historyDays, day);
+    addToIncomeIndex(park->income, getParkedCarsDate(day),
+        getParkedCarsEarnedFee(day));
+}
+
+cents getParkTotalIncome(parkingLot *park){
+    return getIncomeTotal(park->income);
+}
+
+cents getParkIncomeInRange(parkingLot *park, date firstDate, date lastDate){
+    return getIncomeInRange(park->income, firstDate, lastDate);
+}
+
+int isInvalidFee(millicents initialFee, millicents laterFee,
+    millicents maxFee){
+
     if (initialFee <= 0 || laterFee <= 0 || maxFee <= 0) return TRUE;
     if (initialFee > laterFee || laterFee > maxFee) return TRUE;
     return FALSE;
@@ -68,72 +162,74 @@ int isInvalidCapacity(parkingLot* park){
     return (getParkCapacity(park) <= 0);
 }
 
-int pArgumentsAreValid(list *listParks, char *tempName, int capacity,
-    double initialFee, double laterFee, double maxFee){
+int pArgumentsAreValid(parkRegistry *allParks, char *tempName, int capacity,
+    millicents initialFee, millicents laterFee, millicents maxFee){
 
-    if (identityExists(listParks, tempName))
-        printf("%s: parking already exists.\n", tempName);
+    if (searchPark(allParks, tempName) != NULL)
+        writeError(tempName, "parking already exists");
 
-    else if (capacity <= 0)
-        printf("%d: invalid capacity.\n", capacity);
+    else if (capacity <= 0){
+        writeNumber(capacity);
+        writeString(": invalid capacity.\n");
+    }
 
     else if (isInvalidFee(initialFee, laterFee, maxFee))
-        printf("invalid cost.\n");
-
-    else if(getListSize(listParks) == MAXPARKS)
-        printf("too many parks.\n");
+        writeString("invalid cost.\n");
 
     else return TRUE;
 
     return FALSE;
 }
 
+void addCarToPark(parkingLot *park, vehicle *car){
+    info *carIn = createInfo(car, ISVEHICLE);
+
+    addItem(getParkCarsIn(park), carIn);
+    changeCarParkedItem(car, carIn);
+    park->freeSpaces--;
+}
+
 void moveToParkHistory(parkingLot *park, vehicle *car,
-    dateAndHour *logTime, double fee){
+    dateAndHour logTime, cents fee){
 
-    date *logDate = getDate(logTime);
-    hours *logHours = getHours(logTime);
+    date logDate = getDate(logTime);
     parkedCars* prkdCarsSect; //section of parked cars
-    info* carExit=createInfo(createExitVehicle(car,logHours,fee),ISEXITVEHICLE);
 
-    free(popItem(getParkCarsIn(park), getCarRegistration(car)));
+    freeInfoItem(unlinkItem(getParkCarsIn(park), getCarParkedItem(car)));
+    changeCarParkedItem(car, NULL);
+    park->freeSpaces++;
 
-    if ((prkdCarsSect=searchForParkedCars(getParkHistory(park),logDate))==NULL){
-        prkdCarsSect = createParkedCars(logDate);
-        addItemInOrder(getParkHistory(park),
-            createInfo(prkdCarsSect,ISPARKEDCARS));
+    if ((prkdCarsSect = getParkHistoryDay(park, logDate)) == NULL){
+        prkdCarsSect = createParkedCars(getParkArena(park), logDate);
+        addToCalendar(park->historyDays, prkdCarsSect);
     }
-    else{ // in case the parked cars section with that date already exists
-        free(logDate);
-        // pointer to the date in the parked cars section
-        changeDate(logTime, getParkedCarsDate(prkdCarsSect));
-    }
-    addToEarnedFee(prkdCarsSect, fee);
-    addItem(getParkedCarsList(prkdCarsSect), carExit);
+    addExitToParkedCars(prkdCarsSect, getCarRegistration(car),
+        getHours(logTime), fee);
+    addToIncomeIndex(park->income, logDate, fee);
 }
 
-double calculateFee(parkingLot *park, int minutParked){
-    return payment(minutParked, getParkInitialFee(park),
-        getParkLaterFee(park), getParkMaxFee(park));
+cents calculateFee(parkingLot *park, long long minutParked){
+    long long days = minutParked / MINUTESINDAY;
+    int quarters = (minutParked - days * MINUTESINDAY + MINUTESINQUARTER - 1)
+        / MINUTESINQUARTER; // started periods of the last day
+
+    return roundToCents(days * getParkMaxFee(park) + park->dayFees[quarters]);
 }
 
-list* shallowOrderCopyParks(list* listParks){
-    list* copy = createList();
-    info *currentPark = getFirstItem(listParks);
-    info *copyPark;
+void removeParkFromCars(parkingLot *park){
+    int visitor;
 
-    while(currentPark != NULL){
-        copyPark = createInfo(getParkInfo(currentPark), ISPARKINGLOT);
-        addItemInOrder(copy, copyPark);
-        currentPark = getNextItem(currentPark);
-    }
-    return copy;
+    for (visitor = 0; visitor < park->visitorCount; visitor++)
+        if (park->visitors[visitor].car != NULL) // not evicted
+            removeCarHistoryInPark(park->visitors[visitor].car,
+                park->visitors[visitor].historyItem);
 }
 
 void freePark(parkingLot *park){
-    freeCarEntries(getParkCarsIn(park), getParkName(park));
-    freeParkedCarsEntries(getParkHistory(park), getParkName(park));
+    shallowFreeList(getParkCarsIn(park)); // the cars are in the hash table
+    freeArena(getParkArena(park)); // the history and the visitors
+    freeParkedCarsCalendar(park->historyDays);
+    freeIncomeIndex(park->income);
     free(getParkName(park));
-    freeList(getParkCarsIn(park));
     free(park);
 }
@@ -13,31 +13,65 @@
 // Include header file
 #include "project.h"
 
+#define INITIALVISITORS 4 /**< The initial number of visitors of a lot. */
+
 // Forward declaration of structures
 typedef struct list list;
 typedef struct vehicle vehicle;
+typedef struct hashTable hashTable;
+typedef struct parkRegistry parkRegistry;
+typedef struct parkedCars parkedCars;
+typedef struct parkedCarsCalendar parkedCarsCalendar;
+typedef struct incomeIndex incomeIndex;
+typedef struct info info;
+
+/**
+ * @struct parkVisitor
+ * @brief A structure to represent a vehicle that has a history section in a
+ * parking lot. The visitor of a section evicted to the cold store has no
+ * vehicle, and is dropped when the array would grow.
+ */
+typedef struct parkVisitor{
+    vehicle *car; /**< The vehicle, NULL if its section was evicted. */
+    info *historyItem; /**< The item of the section in the vehicle's list of
+        parking history. */
+}parkVisitor;
 
 /**
  * @struct parkingLot
  * @brief A structure to represent a parking lot. This structure represents a
- * parking lot with its name, capacity, fees, and lists of parked cars and
- * parking history.
+ * parking lot with its name, capacity, fees, the list of parked cars and the
+ * parking history. The parking history and the history sections of the
+ * vehicles in the lot are taken from the arena of the lot, so they are all
+ * freed at once with the lot.
  */
 typedef struct parkingLot{
     char* name; /**< The name of the parking lot. */
+    unsigned int number; /**< The order in which the lot was created. */
     int capacity; /**< The capacity of the parking lot. */
-    double initialFee; /**< The initial fee for parking. */
-    double laterFee; /**< The fee for parking after the initial period. */
-    double maxFee; /**< The maximum fee for parking. */
-    struct list *parkHistory; /**< A list of the parking history. */
+    int freeSpaces; /**< The number of free spaces in the parking lot. */
+    millicents initialFee; /**< The initial fee for parking. */
+    millicents laterFee; /**< The fee for parking after the initial period. */
+    millicents maxFee; /**< The maximum fee for parking. */
+    millicents dayFees[QUARTERSINDAY + 1]; /**< The fee of a part of a day,
+        for each number of started 15 minute periods. */
+    memoryArena *arena; /**< The memory of the history of the lot. */
+    parkVisitor *visitors; /**< The vehicles with a history section. */
+    int visitorCount; /**< The number of vehicles with a history section. */
+    int visitorSize; /**< The number of visitors that fit in the array. */
+    int evictedVisitors; /**< The number of visitors without a vehicle. */
+    parkedCarsCalendar *historyDays; /**< The days of the parking history,
+        indexed by date. */
+    incomeIndex *income; /**< The income of the days of the history. */
     struct list *carsIn; /**< A list of the cars currently in the parking lot.*/
 }parkingLot;
 
 /**
  * @brief Creates a new parkingLot structure.
  * This function allocates memory for a new parkingLot structure and initializes
- * it with the given parameters. It also creates two lists: one for the cars
- * currently in the parking lot and another for the parking history.
+ * it with the given parameters. It also creates the list of the cars
+ * currently in the parking lot, the arena and indexes of the parking history,
+ * and computes the fees of a part of a day with dayPayment.
  * @param parkName The name of the parking lot.
  * @param capacity The capacity of the parking lot.
  * @param initialFee The initial fee for parking.
@@ -46,7 +80,7 @@ typedef struct parkingLot{
  * @return parkingLot*: A pointer to the created parkingLot structure.
  */
 parkingLot *createPark(char *parkName, int capacity,
-    double initialFee, double laterFee, double maxFee);
+    millicents initialFee, millicents laterFee, millicents maxFee);
 
 /**
  * @brief Gets the name of a parkingLot structure.
@@ -55,6 +89,20 @@ parkingLot *createPark(char *parkName, int capacity,
  */
 char *getParkName(parkingLot *park);
 
+/**
+ * @brief Gets the number of a parkingLot structure.
+ * @param park A pointer to the parkingLot structure.
+ * @return unsigned int: The order in which the parking lot was created.
+ */
+unsigned int getParkNumber(parkingLot *park);
+
+/**
+ * @brief Changes the number of a parkingLot structure.
+ * @param park A pointer to the parkingLot structure.
+ * @param number The order in which the parking lot was created.
+ */
+void changeParkNumber(parkingLot *park, unsigned int number);
+
 /**
  * @brief Gets the list of cars in a parkingLot structure.
  * @param park A pointer to the parkingLot structure.
@@ -72,30 +120,58 @@ int getParkCapacity(parkingLot *park);
 /**
  * @brief Gets the initial fee of a parkingLot structure.
  * @param park A pointer to the parkingLot structure.
- * @return double: The initial fee of the parking lot.
+ * @return millicents: The initial fee of the parking lot.
  */
-double getParkInitialFee(parkingLot *park);
+millicents getParkInitialFee(parkingLot *park);
 
 /**
  * @brief Gets the later fee of a parkingLot structure.
  * @param park A pointer to the parkingLot structure.
- * @return double: The later fee of the parking lot.
+ * @return millicents: The later fee of the parking lot.
  */
-double getParkLaterFee(parkingLot *park);
+millicents getParkLaterFee(parkingLot *park);
 
 /**
  * @brief Gets the maximum fee of a parkingLot structure.
  * @param park A pointer to the parkingLot structure.
- * @return double: The maximum fee of the parking lot.
+ * @return millicents: The maximum fee of the parking lot.
  */
-double getParkMaxFee(parkingLot *park);
+millicents getParkMaxFee(parkingLot *park);
 
 /**
- * @brief Gets the parking history of a parkingLot structure.
+ * @brief Gets the arena of a parkingLot structure.
  * @param park A pointer to the parkingLot structure.
- * @return list*: The parking history of the parking lot.
+ * @return memoryArena*: The arena of the parking history of the lot.
  */
-list *getParkHistory(parkingLot *park);
+memoryArena *getParkArena(parkingLot *park);
+
+/**
+ * @brief Gets the income by day of a parkingLot structure.
+ * @param park A pointer to the parkingLot structure.
+ * @return incomeIndex*: The days with exits and their income.
+ */
+incomeIndex *getParkIncome(parkingLot *park);
+
+/**
+ * @brief Adds a vehicle to the visitors of a parkingLot structure.
+ * It is called when the vehicle gets a history section in the lot, and keeps
+ * the position of the visitor in the section. When the array is full and at
+ * least half of it are visitors without a vehicle, those are dropped instead
+ * of growing it.
+ * @param park A pointer to the parkingLot structure.
+ * @param car A pointer to the vehicle structure.
+ * @param historyItem The item of the section in the vehicle's history.
+ */
+void addParkVisitor(parkingLot *park, vehicle *car, info *historyItem);
+
+/**
+ * @brief Removes a vehicle from the visitors of a parkingLot structure.
+ * It is called when the history section of the vehicle in the lot is
+ * evicted, the visitor is kept without a vehicle until the array is full.
+ * @param park A pointer to the parkingLot structure.
+ * @param visitorIndex The position of the visitor.
+ */
+void removeParkVisitor(parkingLot *park, int visitorIndex);
 
 /**
  * @brief Gets the number of free spaces in a parkingLot structure.
@@ -104,6 +180,40 @@ list *getParkHistory(parkingLot *park);
  */
 int getParkFreeSpaces(parkingLot *park);
 
+/**
+ * @brief Gets the day of the parking history of a date.
+ * @param park A pointer to the parkingLot structure.
+ * @param logDate The date of the day.
+ * @return parkedCars*: The exits of that day, NULL if there were none.
+ */
+parkedCars *getParkHistoryDay(parkingLot *park, date logDate);
+
+/**
+ * @brief Adds a saved day of the parking history to a parkingLot structure.
+ * The days must be restored by order of date. The day is added to the
+ * calendar and its earned fee to the income by day.
+ * @param park A pointer to the parkingLot structure.
+ * @param day The exits of that day.
+ */
+void restoreParkHistoryDay(parkingLot *park, parkedCars *day);
+
+/**
+ * @brief Gets the total income of a parkingLot structure.
+ * The total is updated on each exit, so the history is not gone through.
+ * @param park A pointer to the parkingLot structure.
+ * @return cents: The sum of the fees of all exits from the parking lot.
+ */
+cents getParkTotalIncome(parkingLot *park);
+
+/**
+ * @brief Gets the income of a parkingLot structure in a range of days.
+ * @param park A pointer to the parkingLot structure.
+ * @param firstDate The first day of the range.
+ * @param lastDate The last day of the range.
+ * @return cents: The sum of the fees of the exits in the range.
+ */
+cents getParkIncomeInRange(parkingLot *park, date firstDate, date lastDate);
+
 /**
  * @brief Checks if the fees are valid.
  * @param initialFee The initial fee for parking.
@@ -111,7 +221,8 @@ int getParkFreeSpaces(parkingLot *park);
  * @param maxFee The maximum fee for parking.
  * @return int: TRUE if the fees are invalid, FALSE otherwise.
  */
-int isInvalidFee(double initialFee, double laterFee, double maxFee);
+int isInvalidFee(millicents initialFee, millicents laterFee,
+    millicents maxFee);
 
 /**
  * @brief Checks if the capacity of a parking lot is invalid.
@@ -122,7 +233,8 @@ int isInvalidCapacity(parkingLot* park);
 
 /**
  * @brief Checks if the arguments for a parking lot are valid.
- * @param listParks A list of all parks.
+ * There is no limit to the number of parks.
+ * @param allParks The registry of all parks.
  * @param tempName The name of the parking lot.
  * @param capacity The capacity of the parking lot.
  * @param initialFee The initial fee for parking.
@@ -130,46 +242,60 @@ int isInvalidCapacity(parkingLot* park);
  * @param maxFee The maximum fee for parking.
  * @return int: TRUE if the arguments are valid, FALSE otherwise.
  */
-int pArgumentsAreValid(list *listParks, char *tempName, int capacity,
-    double initialFee, double laterFee, double maxFee);
+int pArgumentsAreValid(parkRegistry *allParks, char *tempName, int capacity,
+    millicents initialFee, millicents laterFee, millicents maxFee);
+
+/**
+ * @brief Puts a vehicle in the list of cars of the parking lot.
+ * The vehicle keeps its item in the list, so it can leave without the list
+ * being searched, and the lot has one less free space.
+ * @param park A pointer to the parkingLot structure.
+ * @param car A pointer to the vehicle structure.
+ */
+void addCarToPark(parkingLot *park, vehicle *car);
 
 /**
  * @brief Transfers a vehicle from the parking lot to the parking history.
- * Creates an exit record for the vehicle, removes it from the lot,
- * and updates the parking history.
+ * Stores an exit record for the vehicle in the day of the exit, removes it
+ * from the lot through its item in the list of cars, and updates the
+ * parking history.
  * @param park A pointer to the parkingLot structure.
  * @param car A pointer to the vehicle structure.
  * @param logTime The date and hour of parking.
  * @param fee The fee for parking.
  */
 void moveToParkHistory(parkingLot *park, vehicle *car,
-    dateAndHour *logTime, double fee);
+    dateAndHour logTime, cents fee);
 
 /**
  * @brief Calculates the fee for a parked vehicle.
  * This function calculates the fee based on the number of minutes the vehicle
- * was parked, the init fee, the later fee, and the max fee of the parking lot.
+ * was parked, the max fee for each whole day and the fee of the rest of the
+ * day from the park's table, rounded to cents only at the end. The result is
+ * payment's, rounded.
  * @param park A pointer to the parkingLot structure.
  * @param minutParked The number of minutes the vehicle was parked.
- * @return double: The calculated fee.
+ * @return cents: The calculated fee.
  */
-double calculateFee(parkingLot *park, int minutParked);
+cents calculateFee(parkingLot *park, long long minutParked);
 
 /**
- * @brief Creates a shallow ordered copy of parks.
- * This function creates a new list and copies each park from the original list
- * of parks to the new list in order. The parks in the new list are shallow
- * copies of the original items.
- * @param listParks A pointer to the original list.
- * @return list*: A pointer to the new list.
+ * @brief Removes the history of the vehicles in a parking lot.
+ * This function goes through the visitors of the parking lot and unlinks the
+ * history section of each of them, without going through the exits. The
+ * sections evicted to the cold store are dropped when they are loaded.
+ * It must be called before a parking lot is removed, since those sections
+ * are freed with the parking lot.
+ * @param park A pointer to the parkingLot structure.
  */
-list* shallowOrderCopyParks(list* listParks);
+void removeParkFromCars(parkingLot *park);
 
 /**
  * @brief Frees the memory allocated for a parkingLot structure.
- * This function frees the memory allocated for the car entries, parked cars
- * entries, the name of the parking lot, the list of cars in the parking lot,
- * and the parkingLot structure itself.
+ * This function frees the arena with the parking history and the history
+ * sections of the vehicles, the indexes of its days, the list of cars in the
+ * parking lot, the name of the parking lot, and the parkingLot structure
+ * itself. The vehicles are not changed, see removeParkFromCars.
  * @param park A pointer to the parkingLot structure.
  */
 void freePark(parkingLot *park);
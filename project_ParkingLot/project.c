@@ -10,38 +10,147 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
+#include <unistd.h>
 #include "project.h"
+#include "output.h"
+#include "input.h"
 
-// Declare a pointer to the global dateAndHour structure.
-static dateAndHour *globalTime;
+// Declare the global time, the date and hour of the last log.
+static dateAndHour globalTime;
+
+// Declare the journal of accepted commands, NULL if there is none.
+static journal *commandJournal;
+
+// Declare the path of the snapshot of the journal, NULL if there is none.
+static char *snapshotPath;
+
+// Declare the checkpoint being written by a child process, if any.
+static snapshotTask checkpoint;
+
+// Declare the store of completed tickets, NULL if there is no journal.
+static historyStore *ticketStore;
+
+// Declare the store of evicted histories, NULL if no days were given.
+static coldStore *coldCars;
+
+/**
+ * @brief Ends the program when the journal failed, before any more output.
+ * The commands whose records were lost are not answered, like after a crash.
+ */
+static void stopOnJournalFailure(){
+    fprintf(stderr, "journal: cannot write, the last commands are lost.\n");
+    exit(1);
+}
+
+/**
+ * @brief Writes the buffered records of the journal before the output is
+ * flushed, so no answer the user sees is of a command the journal lost.
+ * If the journal failed, the program ends instead.
+ */
+static void flushCommandJournal(){
+    if (!flushJournal(commandJournal)) stopOnJournalFailure();
+}
 
 /**
  * @brief The main function of the program.
- * This function initializes the global time, all parks, and all cars.
+ * This function initializes the global time, all parks, and all cars. If a
+ * journal file is given, the state is rebuilt from its snapshot and its
+ * records, and the accepted commands are added to it, written to the file
+ * before each flush of the output, and if that fails the program ends
+ * without the answers of the lost commands. The completed tickets
+ * are then kept in a history store next to it. If a number of days is also
+ * given, the histories of the vehicles not seen for that long are evicted to
+ * a cold store, and loaded back when the vehicle enters or is viewed.
  * It then enters a loop to read and execute commands until the 'q' command is
- * received. Finally, it frees all allocated memory before exiting.
+ * received or the input ends. The input is mapped in memory when it is a
+ * file, and read in large blocks otherwise. While a checkpoint is being
+ * written, it checks for its end every SNAPSHOTPOLL commands. Finally, it
+ * waits for the checkpoint, syncs the journal and closes the stores.
+ * The memory is only freed one structure at a time when compiled with
+ * FULLFREE, the pools of nodes last.
+ * @param argc The number of arguments.
+ * @param argv The arguments, the optional path of the journal file and the
+ * optional days before a history is evicted.
+ * @return int: 0, or 1 if the journal or the cold store could not be opened,
+ * the journal could not be written or the days are not valid.
  */
-int main(){
+int main(int argc, char *argv[]){
     char *command;
-    list *allParks;
+    parkRegistry *allParks;
     hashTable *allCars;
+    inputReader *reader;
+    long commandCount = 0, days;
+    char *storePath, *coldPath, *end;
 
-    globalTime = createDateAndHour("00-00-0000", "00:00");
-    allParks = createList();
+    initOutput();
+    globalTime = 0; // before any valid date
+    allParks = createParkRegistry();
     allCars = createHashTable();
 
-    command = (char*) malloc(sizeof(char)*BUFSIZ);
-    while ( *(fgets(command, BUFSIZ, stdin)) != 'q')
+    commandJournal = NULL;
+    snapshotPath = NULL;
+    ticketStore = NULL;
+    coldCars = NULL;
+    checkpoint.child = 0;
+    if (argc > 2){
+        days = strtol(argv[2], &end, 10);
+        if (*argv[2] == '\0' || *end != '\0' || days < 0 ||
+            days > LONG_MAX / MINUTESINDAY){
+                fprintf(stderr, "%s: invalid number of days.\n", argv[2]);
+                return 1;
+        }
+        coldPath = createSuffixedPath(argv[1], COLDSUFFIX);
+        coldCars = openColdStore(coldPath, days, allParks);
+        free(coldPath);
+        if (coldCars == NULL){
+            fprintf(stderr, "%s: cannot open cold store.\n", argv[1]);
+            return 1;
+        }
+    }
+    if (argc > 1){
+        snapshotPath = createSuffixedPath(argv[1], SNAPSHOTSUFFIX);
+        storePath = createSuffixedPath(argv[1], HISTORYSUFFIX);
+        commandJournal = loadJournal(argv[1], snapshotPath, storePath,
+            allParks, allCars);
+        free(storePath);
+        if (commandJournal == NULL){
+            fprintf(stderr, "%s: cannot open journal.\n", argv[1]);
+            return 1;
+        }
+        setBeforeFlush(flushCommandJournal);
+    }
+
+    reader = createInputReader(STDIN_FILENO);
+    while ((command = nextLine(reader)) != NULL && *command != 'q'){
         doCommand(command, allParks, allCars);
+        if (checkpoint.child != 0 && (++commandCount % SNAPSHOTPOLL == 0 ||
+            isOutputInteractive()))
+                checkCheckpoint(FALSE);
+        if (isOutputInteractive()){
+            if (!syncJournal(commandJournal)) // an answer seen is never lost
+                stopOnJournalFailure();
+            flushOutput();
+        }
+    }
 
-    free(command);
-    freeList(allParks);
+    checkCheckpoint(TRUE); // the snapshot is whole for the next start
+    if (!closeJournal(commandJournal)) stopOnJournalFailure();
+    commandJournal = NULL; // the last output is flushed after it
+    closeHistoryStore(ticketStore);
+    closeColdStore(coldCars);
+    flushOutput();
+#ifdef FULLFREE // free every structure, to check for leaks with valgrind
+    freeInputReader(reader);
+    freeParkRegistry(allParks);
     freeHashTable(allCars);
-    freeDateAndHour(globalTime);
-    return 0;
+    freeAllNodePools();
+    free(snapshotPath);
+#endif
+    return 0; // otherwise the memory is given back with the process
 }
 
-void doCommand(char *command, list *allParks, hashTable *allCars){
+void doCommand(char *command, parkRegistry *allParks, hashTable *allCars){
     switch(*command){
         case 'p':
             readCommandP(command, allParks);
@@ -64,353 +173,647 @@ void doCommand(char *command, list *allParks, hashTable *allCars){
         case 't':
             readCommandT(command, allParks);
             break;
+        case 'i':
+            readCommandI(command, allParks);
+            break;
+        case 'c':
+            readCommandC(allParks, allCars);
+            break;
+        case 'm':
+            readCommandM(allCars);
+            break;
     }
 }
 
-void readCommandP(char *command,  list *allParks){
-    if (*(command + 2) == '\0') printExistentParks(allParks); //"p\n\0" by fgets
+void readCommandP(char *command,  parkRegistry *allParks){
+    if (!hasMoreTokens(command + 1)) printExistentParks(allParks);
     else processCommandP(command, allParks);
 }
 
-void printExistentParks(list *allParks){
-    info *tempPark = getFirstItem(allParks);
+void printExistentParks(parkRegistry *allParks){
+    info *tempPark = getFirstItem(getRegistryParks(allParks));
 
     while(tempPark != NULL){
         parkingLot *park = getParkInfo(tempPark);
 
-        printf("%s %d %d\n", getParkName(park), getParkCapacity(park),
-        getParkFreeSpaces(park));
+        writeString(getParkName(park));
+        writeChar(' ');
+        writeNumber(getParkCapacity(park));
+        writeChar(' ');
+        writeNumber(getParkFreeSpaces(park));
+        writeChar('\n');
 
         tempPark = getNextItem(tempPark);
     }
 
 }
 
-void processCommandP(char *command, list *allParks){
-    char tempName[BUFSIZ];
-    double initialFee, laterFee, maxFee;
+void processCommandP(char *command, parkRegistry *allParks){
+    char *cursor = command + 1, *tempName;
+    millicents initialFee, laterFee, maxFee;
     short capacity;
     parkingLot *park;
 
-    if (*(command + 2) != '\"')
-        sscanf(command, "p %s %hd %lf %lf %lf", tempName, &capacity,
-            &initialFee, &laterFee, &maxFee);
-    else
-        sscanf(command, "p \"%[^\"]\" %hd %lf %lf %lf", tempName, &capacity,
-            &initialFee, &laterFee, &maxFee);
+    tempName = nextToken(&cursor);
+    capacity = tokenToInt(nextToken(&cursor));
+    initialFee = tokenToMillicents(nextToken(&cursor));
+    laterFee = tokenToMillicents(nextToken(&cursor));
+    maxFee = tokenToMillicents(nextToken(&cursor));
 
     if (pArgumentsAreValid(allParks, tempName, capacity,
         initialFee, laterFee, maxFee)){
 
         park = createPark(tempName, capacity, initialFee, laterFee, maxFee);
-        addItem(allParks, createInfo(park, ISPARKINGLOT));
+        addPark(allParks, park);
+        journalPark(commandJournal, park);
     }
 }
 
-void readCommandE(char *command, list *allParks, hashTable *allCars){
-    char tempParkName[BUFSIZ], tempCarPlate[CARPLATE],tempDate[20],tempHour[20];
-    dateAndHour *logTime;
+void readCommandE(char *command, parkRegistry *allParks, hashTable *allCars){
+    char *cursor = command + 1, *tempParkName, *tempCarPlate, *tempDate;
+    char *tempHour;
+    dateAndHour logTime;
+    plate carPlate;
 
-    if (*(command + 2) != '\"')
-        sscanf(command, "e %s %s %s %s", tempParkName, tempCarPlate,
-            tempDate, tempHour);
-    else
-        sscanf(command, "e \"%[^\"]\" %s %s %s", tempParkName, tempCarPlate,
-            tempDate, tempHour);
+    tempParkName = nextToken(&cursor);
+    tempCarPlate = nextToken(&cursor);
+    tempDate = nextToken(&cursor);
+    tempHour = nextToken(&cursor);
 
+    carPlate = createCarPlate(tempCarPlate);
     logTime = createDateAndHour(tempDate, tempHour);
     if (eArgumentsAreValid(allParks, allCars, tempParkName,
-        tempCarPlate, logTime)){
+        tempCarPlate, carPlate, logTime)){
 
-        putCarInsidePark(allParks, allCars, logTime, tempParkName,tempCarPlate);
+        putCarInsidePark(allParks, allCars, logTime, tempParkName, carPlate);
     }
-    else freeDateAndHour(logTime);
 }
 
-int eArgumentsAreValid(list *allParks, hashTable *allCars, char *tempName,
-    char *tempCarPlate, dateAndHour *timeLog){
+int eArgumentsAreValid(parkRegistry *allParks, hashTable *allCars,
+    char *tempName, char *tempCarPlate, plate carPlate, dateAndHour timeLog){
 
-    parkingLot *park = getParkInfo(searchForItem(allParks, tempName));
-    vehicle *car = getCarInfo(searchInHashTable(allCars, tempCarPlate));
+    parkingLot *park = searchPark(allParks, tempName);
+    vehicle *car = searchInHashTable(allCars, carPlate);
 
     if (park == NULL)
-        printf("%s: no such parking.\n", tempName);
+        writeError(tempName, "no such parking");
 
     else if(getParkFreeSpaces(park) == 0)
-        printf("%s: parking is full.\n", tempName);
+        writeError(tempName, "parking is full");
 
-    else if (!isValidCarPlate(tempCarPlate))
-        printf("%s: invalid licence plate.\n", tempCarPlate);
+    else if (!isValidCarPlate(carPlate))
+        writeError(tempCarPlate, "invalid licence plate");
 
     else if (car != NULL && isCarParked(car))
-        printf("%s: invalid vehicle entry.\n", tempCarPlate);
+        writeError(tempCarPlate, "invalid vehicle entry");
 
     else if (!isValidDateAndHour(timeLog) || !isNewerThen( timeLog, globalTime))
-        printf("invalid date.\n");
+        writeString("invalid date.\n");
 
     else return TRUE;
 
     return FALSE;
 }
 
-void putCarInsidePark(list *allParks, hashTable *allCars, dateAndHour *logTime,
-char *tempParkName, char *tempCarPlate){
+void putCarInsidePark(parkRegistry *allParks, hashTable *allCars,
+    dateAndHour logTime, char *tempParkName, plate carPlate){
+
+    parkingLot *park = searchPark(allParks, tempParkName);
+
+    registerEntry(park, allCars, logTime, carPlate);
+    journalEntry(commandJournal, getParkNumber(park), carPlate, logTime);
+
+    writeString(getParkName(park));
+    writeChar(' ');
+    writeNumber(getParkFreeSpaces(park));
+    writeChar('\n');
+}
+
+void registerEntry(parkingLot *park, hashTable *allCars, dateAndHour logTime,
+    plate carPlate){
 
-    parkingLot *park = getParkInfo(searchForItem(allParks, tempParkName));
-    vehicle *car = getCarInfo(searchInHashTable(allCars, tempCarPlate));
+    vehicle *car = searchInHashTable(allCars, carPlate);
 
     if (car == NULL){
-        car = createCar(tempCarPlate, logTime, getParkName(park));
-        addInHashTable(allCars, createInfo(car, ISVEHICLE));
+        car = createCar(carPlate, logTime, park);
+        addInHashTable(allCars, car);
     }
     else{
-        putNewEntryInCar(car, logTime, getParkName(park));
+        if (isCarCold(car)) loadColdCar(coldCars, car);
+        putNewEntryInCar(car, logTime, park);
         changeCarParkedParkName(car, getParkName(park));
     }
 
-    addItem(getParkCarsIn(park), createInfo(car, ISVEHICLE));
-    copyDateAndHour(globalTime, logTime);
-
-    printf("%s %d\n", getParkName(park), getParkFreeSpaces(park));
+    addCarToPark(park, car);
+    globalTime = logTime;
+    if (coldCars != NULL) evictColdCars(coldCars, logTime);
 }
 
-void readCommandS(char *command, list *allParks, hashTable *allCars){
-    char tempParkName[BUFSIZ], tempCarPlate[CARPLATE],tempDate[20],tempHour[20];
-    dateAndHour *exitTime;
+void readCommandS(char *command, parkRegistry *allParks, hashTable *allCars){
+    char *cursor = command + 1, *tempParkName, *tempCarPlate, *tempDate;
+    char *tempHour;
+    dateAndHour exitTime;
+    plate carPlate;
 
-    if (*(command + 2) != '\"')
-        sscanf(command, "s %s %s %s %s", tempParkName, tempCarPlate,
-            tempDate, tempHour);
-    else
-        sscanf(command, "s \"%[^\"]\" %s %s %s", tempParkName, tempCarPlate,
-            tempDate, tempHour);
+    tempParkName = nextToken(&cursor);
+    tempCarPlate = nextToken(&cursor);
+    tempDate = nextToken(&cursor);
+    tempHour = nextToken(&cursor);
 
+    carPlate = createCarPlate(tempCarPlate);
     exitTime = createDateAndHour(tempDate, tempHour);
     if (sArgumentsAreValid(allParks, allCars, tempParkName,
-        tempCarPlate, exitTime)){
+        tempCarPlate, carPlate, exitTime)){
 
-        putCarOutsidePark(allParks,allCars,exitTime,tempParkName,tempCarPlate);
+        putCarOutsidePark(allParks, allCars, exitTime, tempParkName, carPlate);
     }
-    else freeDateAndHour(exitTime);
 }
 
-int sArgumentsAreValid(list *allParks, hashTable *allCars, char *tempName,
-    char *tempCarPlate, dateAndHour *tempDate){
+int sArgumentsAreValid(parkRegistry *allParks, hashTable *allCars,
+    char *tempName, char *tempCarPlate, plate carPlate, dateAndHour tempDate){
 
-    parkingLot *park = getParkInfo(searchForItem(allParks, tempName));
-    vehicle *car = getCarInfo(searchInHashTable(allCars, tempCarPlate));
+    parkingLot *park = searchPark(allParks, tempName);
+    vehicle *car = searchInHashTable(allCars, carPlate);
 
     if(park == NULL)
-        printf("%s: no such parking.\n", tempName);
+        writeError(tempName, "no such parking");
 
-    else if (!isValidCarPlate(tempCarPlate))
-        printf("%s: invalid licence plate.\n", tempCarPlate);
+    else if (!isValidCarPlate(carPlate))
+        writeError(tempCarPlate, "invalid licence plate");
 
+    // the car keeps the name pointer of its park, so no strcmp is needed
     else if ( car == NULL || !isCarParked(car) ||
-        strcmp(getCarParkedParkName(car), tempName) != 0)
-            printf("%s: invalid vehicle exit.\n", tempCarPlate);
+        getCarParkedParkName(car) != getParkName(park))
+            writeError(tempCarPlate, "invalid vehicle exit");
 
     else if (!isValidDateAndHour(tempDate) || !isNewerThen(tempDate,globalTime))
-        printf("invalid date.\n");
+        writeString("invalid date.\n");
 
     else return TRUE;
 
     return FALSE;
 }
 
-void putCarOutsidePark(list *allParks, hashTable *allCars,
-    dateAndHour *exitTime, char *tempParkName, char *tempCarPlate){
+void putCarOutsidePark(parkRegistry *allParks, hashTable *allCars,
+    dateAndHour exitTime, char *tempParkName, plate carPlate){
 
-    parkingLot *park = getParkInfo(searchForItem(allParks, tempParkName));
-    vehicle *car = getCarInfo(searchInHashTable(allCars, tempCarPlate));
-    float totalPayed;
+    parkingLot *park = searchPark(allParks, tempParkName);
+    vehicle *car = searchInHashTable(allCars, carPlate);
+    dateAndHour entryTime = getCarLastEntryTime(car);
+    cents totalPayed = registerExit(park, car, exitTime,
+        getJournalSize(commandJournal));
 
-    totalPayed = calculateFee(park, minutesParked(car, exitTime));
+    journalExit(commandJournal, getParkNumber(park), carPlate, exitTime);
+    printExitFromPark(car, entryTime, exitTime, totalPayed);
+}
 
-    moveToParkHistory(park, car, exitTime, totalPayed);
-    putNewExitInCar(car, exitTime, totalPayed);
+cents registerExit(parkingLot *park, vehicle *car, dateAndHour exitTime,
+    long journalOffset){
 
-    copyDateAndHour(globalTime, exitTime);
+    cents totalPayed = calculateFee(park, minutesParked(car, exitTime));
 
-    printExitFromPark(car, exitTime, totalPayed);
+    moveToParkHistory(park, car, exitTime, totalPayed);
+    putNewExitInCar(car, exitTime, totalPayed);
     changeCarParkedParkName(car, NULL);
+    if (ticketStore != NULL)
+        storeCarLastTicket(car, ticketStore, getParkNumber(park),
+            journalOffset);
+    if (coldCars != NULL){ // it may be evicted once it is not seen for a while
+        addColdCandidate(coldCars, car);
+        evictColdCars(coldCars, exitTime);
+    }
+
+    globalTime = exitTime;
+    return totalPayed;
 }
 
-void printExitFromPark(vehicle *car, dateAndHour *exitTime, double totalPayed){
-    printf("%s ", getCarRegistration(car));
-    printDateAndHour(getCarLastEntryTime(car));
-    printf(" ");
+void printExitFromPark(vehicle *car, dateAndHour entryTime,
+    dateAndHour exitTime, cents totalPayed){
+
+    printCarPlate(getCarRegistration(car));
+    writeChar(' ');
+    printDateAndHour(entryTime);
+    writeChar(' ');
     printDateAndHour(exitTime);
-    printf(" %.2lf\n", totalPayed);
+    writeChar(' ');
+    writeMoney(totalPayed);
+    writeChar('\n');
 }
 
 void readCommandV(char *command, hashTable *allCars){
-    char tempCarPlate[CARPLATE];
+    char *cursor = command + 1, *tempCarPlate = nextToken(&cursor);
+    plate carPlate = createCarPlate(tempCarPlate);
     vehicle *car;
-    sscanf(command, "v %s", tempCarPlate);
-    car = getCarInfo(searchInHashTable(allCars, tempCarPlate));
+    car = searchInHashTable(allCars, carPlate);
 
-    if (vArgumentsAreValid(car, tempCarPlate)){
+    if (car != NULL && isCarCold(car)){ // it is loaded back and seen now
+        loadColdCar(coldCars, car);
+        changeCarLastSeen(car, globalTime);
+        addColdCandidate(coldCars, car);
+    }
+
+    if (vArgumentsAreValid(car, tempCarPlate, carPlate)){
         info *carHist = getFirstItem(getCarPastParked(car));
 
         printCarEntriesAndExits(carHist);
     }
 }
 
-int vArgumentsAreValid(vehicle *car, char *tempCarPlate){
-    if (!isValidCarPlate(tempCarPlate))
-        printf("%s: invalid licence plate.\n", tempCarPlate);
+int vArgumentsAreValid(vehicle *car, char *tempCarPlate, plate carPlate){
+    if (!isValidCarPlate(carPlate))
+        writeError(tempCarPlate, "invalid licence plate");
 
     else if(car == NULL || getListSize(getCarPastParked(car)) == 0)
-        printf("%s: no entries found in any parking.\n", tempCarPlate);
+        writeError(tempCarPlate, "no entries found in any parking");
 
     else return TRUE;
 
     return FALSE;
 }
 
+/**
+ * @brief Prints an entry and exit of a car in a park.
+ * @param parkName The name of the park.
+ * @param entry The date and time of the entry.
+ * @param exit The date and time of the exit, INVALIDTIME if the car is still
+ * in the park.
+ */
+static void printEntryAndExit(char *parkName, dateAndHour entry,
+    dateAndHour exit){
+
+    writeString(parkName);
+    writeChar(' ');
+    printDateAndHour(entry);
+
+    if (isValidDateAndHour(exit)){
+        writeChar(' ');
+        printDateAndHour(exit);
+    }
+    writeChar('\n');
+}
+
+/**
+ * @brief Prints the entries and exits of a car in a park kept in the history
+ * store. The records are linked from the newest, so their offsets are taken
+ * first and printed from the oldest.
+ * @param section The history section of the car in the park.
+ */
+static void printStoredEntriesAndExits(carHistory *section){
+    int count = getCarHistoryStoredCount(section), position;
+    long *offsets, offset = getCarHistoryLastStored(section);
+    historyRecord *record;
+
+    if (count == 0) return;
+    offsets = (long*) malloc(sizeof(long) * count);
+    for (position = count - 1; position >= 0; position--){
+        offsets[position] = offset;
+        offset = getHistoryRecord(ticketStore, offset)->previous;
+    }
+    for (position = 0; position < count; position++){
+        record = getHistoryRecord(ticketStore, offsets[position]);
+        printEntryAndExit(getCarHistoryName(section), record->entry,
+            record->exit);
+    }
+    free(offsets);
+}
+
 void printCarEntriesAndExits(info *carHist){
-    while(carHist != NULL){ // for each parking the car was in
-        info *ticket = getFirstItem(getCarInOutLog(getCarHistoryInfo(carHist)));
+    carHistory *section;
+    entryAndExit *ticket;
+    int position;
 
-        while (ticket != NULL){ // for each entry and exit
-            printf("%s ", getCarHistoryName(getCarHistoryInfo(carHist)));
-            printDateAndHour( getEntry(getEntryAndExitInfo(ticket)));
+    while(carHist != NULL){ // for each parking the car was in
+        section = getCarHistoryInfo(carHist);
+        printStoredEntriesAndExits(section);
 
-            if (getExit(getEntryAndExitInfo(ticket)) != NULL){
-                printf(" ");
-                printDateAndHour( getExit(getEntryAndExitInfo(ticket)));
-            }
+        // for each entry and exit
+        for (position = 0; position < getCarHistoryTicketCount(section);
+            position++){
 
-            printf("\n");
-            ticket = getNextItem(ticket);
+            ticket = getCarHistoryTicket(section, position);
+            printEntryAndExit(getCarHistoryName(section), getEntry(ticket),
+                getExit(ticket));
         }
         carHist = getNextItem(carHist);
     }
 }
 
-void readCommandF(char *command, list *allParks){
-    char tempParkName[BUFSIZ], dateLog[20];
-    int numArgs;
+void readCommandF(char *command, parkRegistry *allParks){
+    char *cursor = command + 1, *tempParkName, *dateLog;
 
-    if (*(command + 2) != '\"')
-        numArgs = sscanf(command, "f %s %s", tempParkName, dateLog);
-    else
-        numArgs = sscanf(command, "f \"%[^\"]\" %s", tempParkName, dateLog);
+    tempParkName = nextToken(&cursor);
+    dateLog = nextToken(&cursor);
 
-    if (numArgs == 1)
+    if (*dateLog == '\0') // only the park name was given
         printParkIncome(allParks, tempParkName);
     else
         parkIncomeFromCars(allParks, tempParkName, dateLog);
 }
 
-int fArgumentsAreValid(parkingLot *park, date *logDate, char *tempParkName){
-    if (park == NULL){
-        printf("%s: no such parking.\n", tempParkName);
-        freeDate(logDate);
-    }
+int fArgumentsAreValid(parkingLot *park, date logDate, char *tempParkName){
+    if (park == NULL)
+        writeError(tempParkName, "no such parking");
+
     else if (!isValidDate(logDate) ||
-        !(dateIsNewerThen(getDate(globalTime), logDate) ||
-            isSameDate(logDate, getDate(globalTime)))){
+        dateIsNewerThen(logDate, getDate(globalTime)))
+            writeString("invalid date.\n");
 
-        printf("invalid date.\n");
-        freeDate(logDate);
-    }
     else return TRUE;
 
     return FALSE;
 }
 
-void printParkIncome(list *allParks, char *tempParkName){
-    parkingLot *park = getParkInfo(searchForItem(allParks, tempParkName));
-    info *parkedCarsDay;
+void printParkIncome(parkRegistry *allParks, char *tempParkName){
+    parkingLot *park = searchPark(allParks, tempParkName);
+    incomeIndex *income;
+    int day;
 
     if (park == NULL){
-        printf("%s: no such parking.\n", tempParkName);
+        writeError(tempParkName, "no such parking");
         return;
     }
-    parkedCarsDay = getFirstItem(getParkHistory(park));
-    while(parkedCarsDay != NULL){ // for each day in the park history
-        printDate(getParkedCarsDate(getParkedCarsInfo(parkedCarsDay)));
-        printf(" %.2lf\n", getParkedCarsEarnedFee(
-            getParkedCarsInfo(parkedCarsDay)));
-
-        parkedCarsDay = getNextItem(parkedCarsDay);
+    income = getParkIncome(park);
+    for (day = 0; day < getIncomeDayCount(income); day++){ // days with exits
+        printDate(getIncomeDay(income, day));
+        writeChar(' ');
+        writeMoney(getIncomeOfDay(income, day));
+        writeChar('\n');
     }
 }
 
-void parkIncomeFromCars(list *allParks, char *tempParkName, char *dateLog){
-    parkingLot *park = getParkInfo(searchForItem(allParks, tempParkName));
-    date *dateToSearch = createDate(dateLog);
+void parkIncomeFromCars(parkRegistry *allParks, char *tempParkName,
+    char *dateLog){
+
+    parkingLot *park = searchPark(allParks, tempParkName);
+    date dateToSearch = createDate(dateLog);
     parkedCars *parkHistory;
-    info *exitCarInfo;
     exitVehicle *exitCar;
+    int position;
 
     if (fArgumentsAreValid(park, dateToSearch, tempParkName)){
-        parkHistory = searchForParkedCars(getParkHistory(park), dateToSearch);
-        freeDate(dateToSearch);
+        parkHistory = getParkHistoryDay(park, dateToSearch);
 
         if (parkHistory == NULL) // no cars parked in that day
             return;
 
-        exitCarInfo = getFirstItem(getParkedCarsList(parkHistory));
-        while ((exitCar = getExitVehicleInfo(exitCarInfo)) != NULL){
-            printf("%s ", getCarRegistration(getExitVehicleCar(exitCar)));
-            printHours(getExitVehicleExitTime(exitCar));
-            printf(" %.2lf\n", getExitVehiclePayment(exitCar));
+        for (position = 0; position < getParkedCarsCount(parkHistory);
+            position++){
 
-            exitCarInfo = getNextItem(exitCarInfo);
+            exitCar = getParkedCarsExit(parkHistory, position);
+            printCarPlate(getExitVehiclePlate(exitCar));
+            writeChar(' ');
+            printHours(getExitVehicleExitTime(exitCar));
+            writeChar(' ');
+            writeMoney(getExitVehiclePayment(exitCar));
+            writeChar('\n');
         }
     }
 }
 
-void readCommandR(char *command, list *allParks){
+void readCommandR(char *command, parkRegistry *allParks){
     parkingLot *park;
-    list *copyOrdParks;
-    info* parkInfo;
-    char tempParkName[BUFSIZ];
-
-    if (*(command + 2) != '\"')
-        sscanf(command, "r %s", tempParkName);
-    else
-        sscanf(command, "r \"%[^\"]\"", tempParkName);
+    parkOrderNode *orderedPark;
+    char *cursor = command + 1, *tempParkName = nextToken(&cursor);
 
-    if ((park = getParkInfo(searchForItem(allParks, tempParkName))) == NULL)
-        printf("%s: no such parking.\n", tempParkName);
+    if ((park = popPark(allParks, tempParkName)) == NULL)
+        writeError(tempParkName, "no such parking");
     else{
-        free(popItem(allParks, tempParkName));
+        journalRemoval(commandJournal, getParkNumber(park));
+        removeParkFromCars(park);
         freePark(park);
 
-        copyOrdParks = shallowOrderCopyParks(allParks);
-        parkInfo = getFirstItem(copyOrdParks);
-
-        while (parkInfo != NULL){
-            printf("%s\n", getParkName(getParkInfo(parkInfo)));
-            parkInfo = getNextItem(parkInfo);
+        orderedPark = getFirstParkInOrder(allParks);
+        while (orderedPark != NULL){ // the parks are kept in order
+            writeString(getParkName(getOrderedPark(orderedPark)));
+            writeChar('\n');
+            orderedPark = getNextParkInOrder(orderedPark);
         }
-        shallowFreeList(copyOrdParks);
     }
 }
 
-void readCommandT(char *command, list *allParks){
-    char tempParkName[BUFSIZ];
+void readCommandT(char *command, parkRegistry *allParks){
+    char *cursor = command + 1, *tempParkName = nextToken(&cursor);
     parkingLot *park;
-    sscanf(command, "t %s", tempParkName);
-    park = getParkInfo(searchForItem(allParks, tempParkName));
+    park = searchPark(allParks, tempParkName);
     if (park == NULL)
-        printf("%s: no such parking.\n", tempParkName);
+        writeError(tempParkName, "no such parking");
     else
         printParkTotalIncome(park);
 }
 
 
 void printParkTotalIncome(parkingLot *park){
-    info *parkedCarsDay = getFirstItem(getParkHistory(park));
-    double totalIncome = 0;
+    writeMoney(getParkTotalIncome(park));
+    writeChar('\n');
+}
+
+void readCommandI(char *command, parkRegistry *allParks){
+    char *cursor = command + 1, *tempParkName;
+    date firstDate, lastDate;
+    parkingLot *park;
+    info *parkItem;
+    cents income = 0;
+
+    firstDate = createDate(nextToken(&cursor));
+    lastDate = createDate(nextToken(&cursor));
+    tempParkName = nextToken(&cursor);
+
+    if (!isValidDate(firstDate) || !isValidDate(lastDate) ||
+        dateIsNewerThen(firstDate, lastDate)){
+            writeString("invalid date.\n");
+            return;
+    }
+
+    if (*tempParkName != '\0'){ // the income of a single park
+        if ((park = searchPark(allParks, tempParkName)) == NULL){
+            writeError(tempParkName, "no such parking");
+            return;
+        }
+        income = getParkIncomeInRange(park, firstDate, lastDate);
+    }
+    else
+        for (parkItem = getFirstItem(getRegistryParks(allParks));
+            parkItem != NULL; parkItem = getNextItem(parkItem))
+                income += getParkIncomeInRange(getParkInfo(parkItem),
+                    firstDate, lastDate);
+
+    writeMoney(income);
+    writeChar('\n');
+}
+
+void readCommandC(parkRegistry *allParks, hashTable *allCars){
+    if (commandJournal == NULL){
+        writeString("no journal.\n");
+        return;
+    }
+    checkCheckpoint(FALSE); // the previous one is reported if it ended
+    if (checkpoint.child != 0){
+        writeString("checkpoint in progress.\n");
+        return;
+    }
+    if (!syncJournal(commandJournal)) // the snapshot never gets ahead of it
+        stopOnJournalFailure();
+
+    if (startSnapshot(&checkpoint, snapshotPath, allParks, allCars,
+        ticketStore, coldCars, globalTime, getJournalSize(commandJournal)))
+            return;
+    if (writeSnapshot(snapshotPath, allParks, allCars, ticketStore, coldCars,
+        globalTime, getJournalSize(commandJournal)) < 0) // it waits
+            writeString("cannot write snapshot.\n");
+}
+
+void checkCheckpoint(int wait){
+    if (checkpoint.child == 0 || !finishSnapshot(&checkpoint, wait)) return;
+
+    if (checkpoint.bytes < 0)
+        fprintf(stderr, "checkpoint: cannot write snapshot.\n");
+    else
+        fprintf(stderr, "checkpoint: fork pause %.3f ms, %ld bytes written.\n",
+            checkpoint.forkPause, checkpoint.bytes);
+}
+
+void readCommandM(hashTable *allCars){
+    unsigned int position = 0;
+    int residentCount = 0;
+    long residentBytes = 0;
+    vehicle *car;
+
+    while ((car = nextInHashTable(allCars, &position)) != NULL){
+        residentBytes += getCarResidentBytes(car);
+        if (!isCarCold(car)) residentCount++;
+    }
+
+    writeString("resident ");
+    writeNumber(residentCount);
+    writeChar(' ');
+    writeLong(residentBytes);
+    writeChar('\n');
+    writeString("cold ");
+    writeNumber(getColdStoreCount(coldCars));
+    writeChar(' ');
+    writeLong(getColdStoreBytes(coldCars));
+    writeChar('\n');
+    writeString("pool ");
+    writeLong(getPoolAllocations(getInfoPool()));
+    writeChar(' ');
+    writeLong(getPoolNodesInUse(getInfoPool()));
+    writeChar(' ');
+    writeLong(getPoolSlabCount(getInfoPool()));
+    writeChar('\n');
+}
+
+char *createSuffixedPath(char *path, char *suffix){
+    char *newPath = (char*) malloc(strlen(path) + strlen(suffix) + 1);
+
+    strcpy(newPath, path);
+    strcat(newPath, suffix);
+    return newPath;
+}
+
+journal *loadJournal(char *path, char *snapshotFile, char *storeFile,
+    parkRegistry *allParks, hashTable *allCars){
+
+    journalReader *reader;
+    long validBytes = 0, snapshotBytes = 0;
+    int snapshot;
+
+    if ((ticketStore = openHistoryStore(storeFile)) == NULL) return NULL;
+    snapshot = loadSnapshot(snapshotFile, allParks, allCars, ticketStore,
+        &globalTime, &snapshotBytes);
+    if (snapshot == SNAPSHOTINVALID) return NULL;
+    if (snapshot == SNAPSHOTLOADED && coldCars != NULL)
+        addRestoredCandidates(coldCars, allCars);
+    reader = openJournalReader(path);
+    if (reader != NULL){
+        if (!hasJournalMagic(reader) || (snapshot == SNAPSHOTLOADED &&
+            !skipJournalRecords(reader, snapshotBytes))){
+                freeJournalReader(reader); // it is not changed
+                return NULL;
+        }
+        validBytes = replayJournal(reader, allParks, allCars);
+        freeJournalReader(reader);
+    }
+    else if (snapshot == SNAPSHOTLOADED) // the records after it are lost
+        return NULL;
+    endHistoryReplay(ticketStore); // drop the exits the journal lost
+    if (coldCars != NULL) evictColdCars(coldCars, globalTime);
+    return openJournal(path, validBytes);
+}
+
+/**
+ * @brief Applies the creation of a park read from a journal.
+ * @param record A pointer to the record.
+ * @param allParks A pointer to the registry of all parks.
+ * @return int: TRUE if the park was created, FALSE if the record is not
+ * valid.
+ */
+static int replayPark(journalRecord *record, parkRegistry *allParks){
+    if (record->park != getRegistryCreated(allParks) ||
+        searchPark(allParks, record->name) != NULL || record->capacity <= 0 ||
+        isInvalidFee(record->initialFee, record->laterFee, record->maxFee))
+            return FALSE;
+
+    addPark(allParks, createPark(record->name, record->capacity,
+        record->initialFee, record->laterFee, record->maxFee));
+    return TRUE;
+}
+
+/**
+ * @brief Applies an entry, exit or removal of a park read from a journal.
+ * The record is checked like the command was, without the errors written.
+ * @param record A pointer to the record.
+ * @param park The park of the record, NULL if it doesn't exist.
+ * @param allParks A pointer to the registry of all parks.
+ * @param allCars A pointer to the hash table of all cars.
+ * @return int: TRUE if the record was applied, FALSE if it is not valid.
+ */
+static int replayParkRecord(journalRecord *record, parkingLot *park,
+    parkRegistry *allParks, hashTable *allCars){
+
+    vehicle *car;
+
+    if (park == NULL) return FALSE;
+    if (record->type == JOURNALREMOVAL){
+        popPark(allParks, getParkName(park));
+        removeParkFromCars(park);
+        freePark(park);
+        return TRUE;
+    }
+
+    if (!isValidDateAndHour(record->time) ||
+        !isNewerThen(record->time, globalTime))
+            return FALSE;
+
+    car = searchInHashTable(allCars, record->registration);
+    if (record->type == JOURNALENTRY){
+        if (getParkFreeSpaces(park) == 0 ||
+            !isValidCarPlate(record->registration) ||
+            (car != NULL && isCarParked(car)))
+                return FALSE;
+        registerEntry(park, allCars, record->time, record->registration);
+    }
+    else{
+        if (car == NULL || getCarParkedParkName(car) != getParkName(park))
+            return FALSE;
+        registerExit(park, car, record->time, record->offset);
+    }
+    return TRUE;
+}
+
+long replayJournal(journalReader *reader, parkRegistry *allParks,
+    hashTable *allCars){
+
+    long validBytes = getJournalReaderOffset(reader);
+    journalRecord record;
+    int applied = TRUE;
 
-    while(parkedCarsDay != NULL){
-        totalIncome += getParkedCarsEarnedFee(getParkedCarsInfo(parkedCarsDay));
-        parkedCarsDay = getNextItem(parkedCarsDay);
+    while (applied && nextJournalRecord(reader, &record)){
+        if (record.type == JOURNALPARK)
+            applied = replayPark(&record, allParks);
+        else
+            applied = replayParkRecord(&record, searchParkByNumber(allParks,
+                record.park), allParks, allCars);
+        if (applied) validBytes = getJournalReaderOffset(reader);
     }
-    printf("%.2lf\n", totalIncome);
+    return validBytes;
 }
@@ -11,7 +11,10 @@
 #define PROJECT_h
 
 // Include header files
+#include "carPlate.h"
 #include "dateAndHour.h"
+#include "nodePool.h"
+#include "memoryArena.h"
 #include "info.h"
 #include "parkedCars.h"
 #include "parkingLot.h"
@@ -19,60 +22,67 @@
 #include "carHistoryAndEntryExit.h"
 #include "vehicleAndExitVehicle.h"
 #include "hashingTable.h"
+#include "parkRegistry.h"
+#include "incomeIndex.h"
+#include "tokenizer.h"
+#include "journal.h"
+#include "snapshot.h"
+#include "historyStore.h"
+#include "coldStore.h"
 
-#define MAXPARKS 20 /**< Maximum number of parks allowed */
 #define TRUE 1      /**< Represents a boolean true value */
 #define FALSE 0     /**< Represents a boolean false value */
 
 // Forward declaration of structures
 typedef struct info info;
 typedef struct hashTable hashTable;
+typedef struct parkRegistry parkRegistry;
 
 /**
  * @brief Executes a command.
  * This function takes a command and executes it based on its first character.
  * @param command The command to be executed.
- * @param allParks A pointer to the list of all parks.
+ * @param allParks A pointer to the registry of all parks.
  * @param allCars A pointer to the hash table of all cars.
  */
-void doCommand(char *command, list *allParks, hashTable *allCars);
+void doCommand(char *command, parkRegistry *allParks, hashTable *allCars);
 
 /**
  * @brief Processes the 'p' command.
  * This function checks if the command is 'p', if is just 'p' it prints all
  * existing parks. Otherwise, it processes the command.
  * @param command The command to be processed.
- * @param allParks A pointer to the list of all parks.
+ * @param allParks A pointer to the registry of all parks.
  */
-void readCommandP(char *command,  list *allParks);
+void readCommandP(char *command,  parkRegistry *allParks);
 
 /**
  * @brief Prints all existing parks.
  * This function prints by order of creation all existing parks.
  * It prints the park's name, capacity, and number of free spaces.
- * @param allParks A pointer to the list of all parks.
+ * @param allParks A pointer to the registry of all parks.
  */
-void printExistentParks(list *allParks);
+void printExistentParks(parkRegistry *allParks);
 
 /**
  * @brief Processes the 'p' command.
  * This function reads the parameters of the 'p' command, checks if the
  * parameters are valid. If they are, it creates a new park and adds it to the
- * list of all parks.
+ * registry of all parks.
  * @param command The command to be processed.
- * @param allParks A pointer to the list of all parks.
+ * @param allParks A pointer to the registry of all parks.
  */
-void processCommandP(char *command, list *allParks);
+void processCommandP(char *command, parkRegistry *allParks);
 
 /**
  * @brief Processes the 'e' command.
  * This function reads the parameters of the 'e' command, checks if the
  * parameters are valid. If they are, it puts the car inside the specified park.
  * @param command The command to be processed.
- * @param allParks A pointer to the list of all parks.
+ * @param allParks A pointer to the registry of all parks.
  * @param allCars A pointer to the hash table of all cars.
  */
-void readCommandE(char *command, list *allParks, hashTable* allCars);
+void readCommandE(char *command, parkRegistry *allParks, hashTable* allCars);
 
 /**
  * @brief Validates the arguments of the 'e' command.
@@ -80,39 +90,55 @@ void readCommandE(char *command, list *allParks, hashTable* allCars);
  * if the car plate is valid, if the car is already parked, and if the date and
  * time are valid and later than the global time. If all checks pass, it returns
  * TRUE. Otherwise, it prints an error message and returns FALSE.
- * @param allParks A pointer to the list of all parks.
+ * @param allParks A pointer to the registry of all parks.
  * @param allCars A pointer to the hash table of all cars.
  * @param tempName The name of the park.
- * @param tempCarPlate The license plate of the car.
+ * @param tempCarPlate The license plate of the car, as it was written.
+ * @param carPlate The license plate of the car, INVALIDPLATE if not valid.
  * @param timeLog The date and time of the log.
  * @return int: TRUE if all arguments are valid, FALSE otherwise.
  */
-int eArgumentsAreValid(list *allParks, hashTable *allCars, char *tempName,
-    char *tempCarPlate, dateAndHour *timeLog);
+int eArgumentsAreValid(parkRegistry *allParks, hashTable *allCars,
+    char *tempName, char *tempCarPlate, plate carPlate, dateAndHour timeLog);
 
 /**
  * @brief Puts a car inside a park.
- * This function gets the park and car information from the list of all parks
- * and the hash table of all cars. If the car does not exist, it creates a car.
- * It then updates the car's status and the park's number of free spaces.
- * @param allParks A pointer to the list of all parks.
+ * This function gets the park and car information from the registry of all
+ * parks and the hash table of all cars, and registers the entry with
+ * registerEntry. It then adds the entry to the journal and prints the park's
+ * number of free spaces.
+ * @param allParks A pointer to the registry of all parks.
  * @param allCars A pointer to the hash table of all cars.
  * @param logTime The date and time of the log.
  * @param tempParkName The name of the park.
- * @param tempCarPlate The license plate of the car.
+ * @param carPlate The license plate of the car.
  */
-void putCarInsidePark(list *allParks, hashTable *allCars, dateAndHour *logTime,
-    char *tempParkName, char *tempCarPlate);
+void putCarInsidePark(parkRegistry *allParks, hashTable *allCars,
+    dateAndHour logTime, char *tempParkName, plate carPlate);
+
+/**
+ * @brief Puts a car inside a park, without writing the answer.
+ * This function creates the car if it does not exist, adds a new entry to its
+ * history, puts it in the park and updates the global time. A history
+ * evicted to the cold store is loaded back first, and the vehicles not seen
+ * for its days are evicted after. The arguments must be valid.
+ * @param park A pointer to the park.
+ * @param allCars A pointer to the hash table of all cars.
+ * @param logTime The date and time of the entry.
+ * @param carPlate The license plate of the car.
+ */
+void registerEntry(parkingLot *park, hashTable *allCars, dateAndHour logTime,
+    plate carPlate);
 
 /**
  * @brief Processes the 's' command.
  * This function reads the parameters of the 's' command checks if the
  * parameters are valid. If they are, puts the car outside the specified park.
  * @param command The command to be processed.
- * @param allParks A pointer to the list of all parks.
+ * @param allParks A pointer to the registry of all parks.
  * @param allCars A pointer to the hash table of all cars.
  */
-void readCommandS(char *command, list *allParks, hashTable *allCars);
+void readCommandS(char *command, parkRegistry *allParks, hashTable *allCars);
 
 /**
  * @brief Validates the arguments of the 's' command.
@@ -120,44 +146,65 @@ void readCommandS(char *command, list *allParks, hashTable *allCars);
  * if the car is parked, and if the date and time are valid and later than the
  * global time. If all checks pass, it returns TRUE. Otherwise,
  * it prints an error message and returns FALSE.
- * @param allParks A pointer to the list of all parks.
+ * @param allParks A pointer to the registry of all parks.
  * @param allCars A pointer to the hash table of all cars.
  * @param tempName The name of the park.
- * @param tempCarPlate The license plate of the car.
+ * @param tempCarPlate The license plate of the car, as it was written.
+ * @param carPlate The license plate of the car, INVALIDPLATE if not valid.
  * @param tempDate The date and time of the log.
  * @return int: TRUE if all arguments are valid, FALSE otherwise.
  */
-int sArgumentsAreValid(list *allParks, hashTable *allCars, char *tempName,
-    char *tempCarPlate, dateAndHour *tempDate);
+int sArgumentsAreValid(parkRegistry *allParks, hashTable *allCars,
+    char *tempName, char *tempCarPlate, plate carPlate, dateAndHour tempDate);
 
 /**
  * @brief Puts a car outside a park.
- * This function gets the park and car information from the list of all parks
- * and the hash table of all cars. It then calculates the fee, moves the car to
- * the park's history, updates the car's status and prints the exit information.
- * @param allParks A pointer to the list of all parks.
+ * This function gets the park and car information from the registry of all
+ * parks and the hash table of all cars, and registers the exit with
+ * registerExit. It then adds the exit to the journal and prints the exit
+ * information.
+ * @param allParks A pointer to the registry of all parks.
  * @param allCars A pointer to the hash table of all cars.
  * @param exitTime The date and time of the exit.
  * @param tempParkName The name of the park.
- * @param tempCarPlate The license plate of the car.
+ * @param carPlate The license plate of the car.
+ */
+void putCarOutsidePark(parkRegistry *allParks, hashTable *allCars,
+    dateAndHour exitTime, char *tempParkName, plate carPlate);
+
+/**
+ * @brief Puts a car outside a park, without writing the answer.
+ * This function calculates the fee, moves the car to the park's history, adds
+ * the exit to the car's history and updates the global time. If there is a
+ * history store, the completed ticket is moved to it. With a cold store, the
+ * car becomes a candidate for eviction, and the vehicles not seen for its
+ * days are evicted. The arguments must be valid.
+ * @param park A pointer to the park.
+ * @param car A pointer to the car, parked in that park.
+ * @param exitTime The date and time of the exit.
+ * @param journalOffset The offset of the exit in the journal.
+ * @return cents: The fee paid by the car.
  */
-void putCarOutsidePark(list *allParks, hashTable *allCars,
-    dateAndHour *exitTime, char *tempParkName, char *tempCarPlate);
+cents registerExit(parkingLot *park, vehicle *car, dateAndHour exitTime,
+    long journalOffset);
 
 /**
  * @brief Prints the exit information of a car from a park.
  * This function prints the car's license plate, the entry time, the exit time,
  * and the total fee paid.
  * @param car A pointer to the car.
+ * @param entryTime The date and time of the entry.
  * @param exitTime The date and time of the exit.
  * @param totalPayed The total fee paid by the car.
  */
-void printExitFromPark(vehicle *car, dateAndHour *exitTime, double totalPayed);
+void printExitFromPark(vehicle *car, dateAndHour entryTime,
+    dateAndHour exitTime, cents totalPayed);
 
 /**
  * @brief Processes the 'v' command.
  * This function reads the parameters of the 'v' command checks if the
- * parameters are valid. If they are, it gets the car's history.
+ * parameters are valid. If they are, it gets the car's history. A history
+ * evicted to the cold store is loaded back first, and the car counts as seen.
  * @param command The command to be processed.
  * @param allCars A pointer to the hash table of all cars.
  */
@@ -169,15 +216,18 @@ void readCommandV(char *command, hashTable *allCars);
  * of entries and exits. If all checks pass, it returns TRUE.
  * Otherwise, it prints an error message and returns FALSE.
  * @param car A pointer to the car.
- * @param tempCarPlate The license plate of the car.
+ * @param tempCarPlate The license plate of the car, as it was written.
+ * @param carPlate The license plate of the car, INVALIDPLATE if not valid.
  * @return int: TRUE if all arguments are valid, FALSE otherwise.
  */
-int vArgumentsAreValid(vehicle *car, char *tempCarPlate);
+int vArgumentsAreValid(vehicle *car, char *tempCarPlate, plate carPlate);
 
 /**
  * @brief Prints the entries and exits of a car.
  * This function iterates through the car's history and prints each entry
  * and exit. It prints the park's name, the entry time, and the exit time.
+ * The tickets of each park in the history store come before the ones in
+ * memory, which are newer.
  * @param carHist A pointer to the car's history.
  */
 void printCarEntriesAndExits(info *carHist);
@@ -187,9 +237,9 @@ void printCarEntriesAndExits(info *carHist);
  * This function reads the parameters of the 'f' command checks if the
  * parameters are valid. If they are, it prints the park's financial report.
  * @param command The command to be processed.
- * @param allParks A pointer to the list of all parks.
+ * @param allParks A pointer to the registry of all parks.
  */
-void readCommandF(char *command, list *allParks);
+void readCommandF(char *command, parkRegistry *allParks);
 
 /**
  * @brief Validates the arguments of the 'f' command.
@@ -201,47 +251,48 @@ void readCommandF(char *command, list *allParks);
  * @param tempParkName The name of the park.
  * @return int: TRUE if all arguments are valid, FALSE otherwise.
  */
-int fArgumentsAreValid(parkingLot *park, date *logDate, char *tempParkName);
+int fArgumentsAreValid(parkingLot *park, date logDate, char *tempParkName);
 
 /**
  * @brief Prints the income of a parking lot for each day.
  * This function retrieves the parking lot with the given name from the list of
  * all parking lots. If the parking lot exists, it iterates over
- * its history and for each day, it prints the date and the earned fee.
- * @param allParks A pointer to the list of all parking lots.
+ * the days of its income index and for each day, it prints the date and the
+ * earned fee.
+ * @param allParks A pointer to the registry of all parking lots.
  * @param tempParkName The name of the parking lot.
  */
-void printParkIncome(list *allParks, char *tempParkName);
+void printParkIncome(parkRegistry *allParks, char *tempParkName);
 
 /**
  * @brief Prints the income from cars parked in a park on a specific date.
- * This function gets the park information from the list of all parks and the
- * date. It then checks if the arguments are valid. If they are,
+ * This function gets the park information from the registry of all parks and
+ * the date. It then checks if the arguments are valid. If they are,
  * it gets the park's history for the specified date and prints
  * the car's license plate, exit time, and fee paid.
- * @param allParks A pointer to the list of all parks.
+ * @param allParks A pointer to the registry of all parks.
  * @param tempParkName The name of the park.
  * @param dateLog The date of the log.
  */
-void parkIncomeFromCars(list *allParks, char *tempParkName, char *dateLog);
+void parkIncomeFromCars(parkRegistry *allParks, char *tempParkName,
+    char *dateLog);
 
 /**
  * @brief Processes the 'r' command.
  * This function reads the park name from the 'r' command. It then retrieves the
- * park information from the list of all parks. If the park does not exist, it
- * prints an error message. If the park exists, it removes the park from the
- * list of all parks, frees the park's memory, and prints the names of the
- * remaining parks in alphabetical order.
+ * park information from the registry of all parks. If the park does not exist,
+ * it prints an error message. If the park exists, it removes the park from the
+ * registry of all parks and from the history of its vehicles, frees the park's
+ * memory, and prints the names of the remaining parks in alphabetical order.
  * @param command The command to be processed.
- * @param allParks A pointer to the list of all parks.
+ * @param allParks A pointer to the registry of all parks.
  */
-void readCommandR(char *command, list *allParks);
+void readCommandR(char *command, parkRegistry *allParks);
 
 /**
- * @brief Calculates and prints the total income of a park.
- * This function iterates over the history of parked cars in the park,
- * summing up the income from each day. It then prints the total income to the
- * standard output.
+ * @brief Prints the total income of a park.
+ * This function prints the running total of the park's income, kept up to
+ * date on each exit, to the standard output.
  * @param park A pointer to the park structure.
  */
 void printParkTotalIncome(parkingLot *park);
@@ -249,13 +300,101 @@ void printParkTotalIncome(parkingLot *park);
 /**
  * @brief Processes the 't' command.
  * This function reads the park name from the 't' command. It then retrieves the
- * park information from the list of all parks. If the park does not exist, it
- * prints an error message. If the park exists, it calculates and prints the
+ * park information from the registry of all parks. If the park does not exist,
+ * it prints an error message. If the park exists, it calculates and prints the
  * total income of the park.
  * @param command The command to be processed.
- * @param allParks A pointer to the list of all parks.
+ * @param allParks A pointer to the registry of all parks.
+ */
+void readCommandT(char *command, parkRegistry *allParks);
+
+/**
+ * @brief Processes the 'i' command.
+ * This function reads the first and last dates of a range and an optional
+ * park name from the 'i' command. If the dates are not valid or the range
+ * ends before it starts, it prints an error message. Otherwise, it prints the
+ * income of the park in that range, or of all parks if no name was given.
+ * If the park does not exist, it prints an error message.
+ * @param command The command to be processed.
+ * @param allParks A pointer to the registry of all parks.
+ */
+void readCommandI(char *command, parkRegistry *allParks);
+
+/**
+ * @brief Processes the 'c' command.
+ * This function syncs the journal and starts a checkpoint, a child process
+ * that writes a snapshot of the whole state next to the journal, with the
+ * size of the journal it covers, so a restart only replays the records after
+ * it. The commands go on while the child writes. If the fork fails, the
+ * snapshot is written before going on. If there is no journal, a checkpoint
+ * is still being written, or the snapshot could not be written, it prints an
+ * error message.
+ * @param allParks A pointer to the registry of all parks.
+ * @param allCars A pointer to the hash table of all cars.
+ */
+void readCommandC(parkRegistry *allParks, hashTable *allCars);
+
+/**
+ * @brief Collects a checkpoint that has ended and reports it.
+ * The report, with the milliseconds the fork stopped the program and the
+ * bytes written, goes to the standard error, since it comes after other
+ * commands' answers.
+ * @param wait TRUE to wait for the checkpoint to end, FALSE to only check.
+ */
+void checkCheckpoint(int wait);
+
+/**
+ * @brief Processes the 'm' command.
+ * This function prints the number of vehicles with their history in memory
+ * and the bytes in memory of all vehicles, the evicted ones only taking
+ * their structure, then the number of evicted vehicles and the bytes of
+ * their segments in the cold store, and last the counters of the pool of
+ * list items.
+ * @param allCars A pointer to the hash table of all cars.
+ */
+void readCommandM(hashTable *allCars);
+
+/**
+ * @brief Creates a path with a suffix added to another.
+ * @param path The path.
+ * @param suffix The suffix, like SNAPSHOTSUFFIX.
+ * @return char*: The new path, to be freed.
+ */
+char *createSuffixedPath(char *path, char *suffix);
+
+/**
+ * @brief Rebuilds the state from a journal and opens it to add commands.
+ * If there is a snapshot, the state is restored from it and only the records
+ * after it are replayed. If the journal file exists, its records are
+ * replayed, and the bytes after the last valid one, like a record cut by a
+ * crash, are dropped. Otherwise a new journal is created. The history store
+ * is opened first, and the replayed exits use its records instead of
+ * writing them again. With a cold store, the vehicles restored from the
+ * snapshot become candidates for eviction, and those not seen for its days
+ * by the last log are evicted.
+ * @param path The path of the journal file.
+ * @param snapshotFile The path of the snapshot of the journal.
+ * @param storeFile The path of the history store of the journal.
+ * @param allParks A pointer to the registry of all parks.
+ * @param allCars A pointer to the hash table of all cars.
+ * @return journal*: The journal, NULL if the file could not be opened, is
+ * not a journal, or does not match its snapshot or history store.
+ */
+journal *loadJournal(char *path, char *snapshotFile, char *storeFile,
+    parkRegistry *allParks, hashTable *allCars);
+
+/**
+ * @brief Applies the records of a journal to the parks and cars.
+ * The records are applied with the same functions as the commands, without
+ * parsing text or writing answers, until the end of the journal or the first
+ * record that is not valid.
+ * @param reader A pointer to the reader of the journal.
+ * @param allParks A pointer to the registry of all parks.
+ * @param allCars A pointer to the hash table of all cars.
+ * @return long: The number of bytes of the magic and the valid records.
  */
-void readCommandT(char *command, list *allParks);
+long replayJournal(journalReader *reader, parkRegistry *allParks,
+    hashTable *allCars);
 
 
 #endif
@@ -0,0 +1,696 @@
+/**
+ * @file snapshot.c
+ * @brief This file contains the implementation of the snapshots of the
+ * state, written and read in binary.
+ */
+
+// Include necessary libraries and header files
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include "snapshot.h"
+#include "project.h"
+
+/**
+ * @brief Updates the checksum of a snapshot with a block of bytes.
+ * The block is read in words of 8 bytes, and its last bytes one by one, so
+ * blocks must start at offsets multiple of 8.
+ * @param checksum The checksum of the bytes before.
+ * @param bytes The block.
+ * @param size The number of bytes of the block.
+ * @return unsigned long long: The checksum with the block.
+ */
+static unsigned long long addBlockToChecksum(unsigned long long checksum,
+    char *bytes, size_t size){
+
+    unsigned long long word;
+
+    for (; size >= sizeof(word); size -= sizeof(word), bytes += sizeof(word)){
+        memcpy(&word, bytes, sizeof(word));
+        checksum = (checksum ^ word) * SNAPSHOTPRIME;
+    }
+    while (size-- > 0)
+        checksum = (checksum ^ (unsigned char) *bytes++) * SNAPSHOTPRIME;
+    return checksum;
+}
+
+/**
+ * @brief Writes the buffer of a snapshot writer to its file.
+ * The buffer is only written when full, or at the end, so every block
+ * starts at an offset multiple of 8.
+ * @param writer A pointer to the snapshotWriter structure.
+ */
+static void flushSnapshot(snapshotWriter *writer){
+    char *data = writer->buffer;
+    ssize_t written;
+    size_t left = writer->used;
+
+    writer->checksum = addBlockToChecksum(writer->checksum, data, left);
+    while (left > 0 && !writer->failed){
+        written = write(writer->fd, data, left);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) writer->failed = TRUE; // the disk is full or failed
+        else{
+            data += written;
+            left -= written;
+        }
+    }
+    writer->used = 0;
+}
+
+/**
+ * @brief Adds some bytes to a snapshot.
+ * @param writer A pointer to the snapshotWriter structure.
+ * @param data The bytes to add.
+ * @param size The number of bytes.
+ */
+static void putBytes(snapshotWriter *writer, void *data, size_t size){
+    char *bytes = (char*) data;
+    size_t part;
+
+    writer->size += size;
+    while (size > 0){
+        if (writer->used == SNAPSHOTBUFFER) flushSnapshot(writer);
+        part = SNAPSHOTBUFFER - writer->used;
+        if (part > size) part = size;
+
+        memcpy(writer->buffer + writer->used, bytes, part);
+        writer->used += part;
+        bytes += part;
+        size -= part;
+    }
+}
+
+/**
+ * @brief Adds zeros to a snapshot until its size is a multiple of
+ * SNAPSHOTALIGN, before an array.
+ * @param writer A pointer to the snapshotWriter structure.
+ */
+static void putAlignment(snapshotWriter *writer){
+    char zeros[SNAPSHOTALIGN] = {0};
+
+    if (writer->size % SNAPSHOTALIGN != 0)
+        putBytes(writer, zeros, SNAPSHOTALIGN - writer->size % SNAPSHOTALIGN);
+}
+
+/**
+ * @brief Adds a park and its days of exits to a snapshot.
+ * @param writer A pointer to the snapshotWriter structure.
+ * @param park A pointer to the park.
+ */
+static void putPark(snapshotWriter *writer, parkingLot *park){
+    incomeIndex *income = getParkIncome(park);
+    unsigned int number = getParkNumber(park);
+    unsigned int nameLength = strlen(getParkName(park)) + 1;
+    int capacity = getParkCapacity(park), dayCount, day, exitCount;
+    millicents fees[3];
+    parkedCars *parkDay;
+    date parkDate;
+
+    fees[0] = getParkInitialFee(park);
+    fees[1] = getParkLaterFee(park);
+    fees[2] = getParkMaxFee(park);
+    dayCount = getIncomeDayCount(income);
+
+    putBytes(writer, &number, sizeof(unsigned int));
+    putBytes(writer, &capacity, sizeof(int));
+    putBytes(writer, fees, sizeof(fees));
+    putBytes(writer, &nameLength, sizeof(unsigned int));
+    putBytes(writer, &dayCount, sizeof(int));
+    putBytes(writer, getParkName(park), nameLength);
+
+    for (day = 0; day < dayCount; day++){ // the days with exits, in order
+        parkDate = getIncomeDay(income, day);
+        parkDay = getParkHistoryDay(park, parkDate);
+        exitCount = getParkedCarsCount(parkDay);
+
+        putAlignment(writer);
+        putBytes(writer, &parkDate, sizeof(date));
+        putBytes(writer, &exitCount, sizeof(int));
+        putBytes(writer, getParkedCarsExit(parkDay, 0),
+            sizeof(exitVehicle) * exitCount);
+    }
+}
+
+/**
+ * @brief Gets the number of the park with a name, for a snapshot.
+ * @param allParks A pointer to the registry of all parks.
+ * @param parkName The name of the park, NULL if there is none.
+ * @return unsigned int: The number of the park, SNAPSHOTNOPARK if the name
+ * is NULL.
+ */
+static unsigned int getSnapshotParkNumber(parkRegistry *allParks,
+    char *parkName){
+
+    if (parkName == NULL) return SNAPSHOTNOPARK;
+    return getParkNumber(searchPark(allParks, parkName));
+}
+
+/**
+ * @brief Adds the fields of a vehicle before its history sections to a
+ * snapshot.
+ * @param writer A pointer to the snapshotWriter structure.
+ * @param allParks A pointer to the registry of all parks.
+ * @param car A pointer to the vehicle.
+ * @param lastSection The section of the last entry, -1 if none.
+ * @param sectionCount The number of sections.
+ */
+static void putCarHeader(snapshotWriter *writer, parkRegistry *allParks,
+    vehicle *car, int lastSection, int sectionCount){
+
+    plate registration = getCarRegistration(car);
+    unsigned int insidePark;
+    dateAndHour lastSeen = getCarLastSeen(car);
+
+    insidePark = getSnapshotParkNumber(allParks, getCarParkedParkName(car));
+    putAlignment(writer);
+    putBytes(writer, &registration, sizeof(plate));
+    putBytes(writer, &insidePark, sizeof(unsigned int));
+    putBytes(writer, &lastSection, sizeof(int));
+    putBytes(writer, &sectionCount, sizeof(int));
+    putBytes(writer, &lastSeen, sizeof(dateAndHour));
+}
+
+/**
+ * @brief Adds a history section of a vehicle to a snapshot.
+ * @param writer A pointer to the snapshotWriter structure.
+ * @param sectionPark The number of the park of the section.
+ * @param tickets The tickets in memory.
+ * @param ticketCount The number of tickets in memory.
+ * @param storedCount The number of tickets in the history store.
+ * @param lastStored The offset of the newest stored ticket, or 0.
+ */
+static void putSection(snapshotWriter *writer, unsigned int sectionPark,
+    entryAndExit *tickets, int ticketCount, int storedCount, long lastStored){
+
+    putAlignment(writer);
+    putBytes(writer, &lastStored, sizeof(long));
+    putBytes(writer, &sectionPark, sizeof(unsigned int));
+    putBytes(writer, &ticketCount, sizeof(int));
+    putBytes(writer, &storedCount, sizeof(int));
+    putAlignment(writer);
+    putBytes(writer, tickets, sizeof(entryAndExit) * ticketCount);
+}
+
+/**
+ * @brief Adds a vehicle and its history sections to a snapshot.
+ * @param writer A pointer to the snapshotWriter structure.
+ * @param allParks A pointer to the registry of all parks.
+ * @param car A pointer to the vehicle, not evicted.
+ */
+static void putCar(snapshotWriter *writer, parkRegistry *allParks,
+    vehicle *car){
+
+    int sectionCount = getListSize(getCarPastParked(car));
+    int lastSection = -1, section = 0;
+    carHistory *carHist;
+    info *item;
+
+    for (item = getFirstItem(getCarPastParked(car)); item != NULL;
+        item = getNextItem(item), section++)
+            if (getCarHistoryInfo(item) == getCarLastHistory(car))
+                lastSection = section;
+    putCarHeader(writer, allParks, car, lastSection, sectionCount);
+
+    for (item = getFirstItem(getCarPastParked(car)); item != NULL;
+        item = getNextItem(item)){
+
+        carHist = getCarHistoryInfo(item);
+        putSection(writer, getSnapshotParkNumber(allParks,
+            getCarHistoryName(carHist)), getCarHistoryTicket(carHist, 0),
+            getCarHistoryTicketCount(carHist),
+            getCarHistoryStoredCount(carHist),
+            getCarHistoryLastStored(carHist));
+    }
+}
+
+/**
+ * @brief Adds a vehicle evicted to the cold store to a snapshot, with the
+ * history sections read from its segment, as if it was in memory.
+ * The sections of parks removed since the eviction are left out.
+ * @param writer A pointer to the snapshotWriter structure.
+ * @param allParks A pointer to the registry of all parks.
+ * @param cold A pointer to the cold store.
+ * @param car A pointer to the evicted vehicle.
+ */
+static void putColdCar(snapshotWriter *writer, parkRegistry *allParks,
+    coldStore *cold, vehicle *car){
+
+    coldHistory *history = readColdSegment(cold, getCarColdSegment(car));
+    int lastSection = -1, sectionCount = 0, section;
+    coldSection *sections;
+
+    if (history == NULL){
+        writer->failed = TRUE; // a snapshot without the history is not valid
+        return;
+    }
+
+    sections = history->sections;
+    for (section = 0; section < history->sectionCount; section++)
+        if (searchParkByNumber(allParks, sections[section].park) != NULL){
+            if (section == history->lastSection) lastSection = sectionCount;
+            sectionCount++;
+        }
+    putCarHeader(writer, allParks, car, lastSection, sectionCount);
+
+    for (section = 0; section < history->sectionCount; section++)
+        if (searchParkByNumber(allParks, sections[section].park) != NULL)
+            putSection(writer, sections[section].park,
+                sections[section].tickets, sections[section].ticketCount,
+                sections[section].storedCount, sections[section].lastStored);
+}
+
+/**
+ * @brief Adds a batch of vehicles to a snapshot.
+ * The vehicles come in the order of the slots of the hash table, scattered
+ * in memory, so the structures down to the first history section of each are
+ * fetched one level at a time for the whole batch. The misses of a level
+ * overlap, instead of each vehicle waiting for its own chain of them.
+ * @param writer A pointer to the snapshotWriter structure.
+ * @param allParks A pointer to the registry of all parks.
+ * @param cold A pointer to the cold store, or NULL.
+ * @param cars The vehicles of the batch.
+ * @param count The number of vehicles, at most SNAPSHOTBATCH.
+ */
+static void putCarBatch(snapshotWriter *writer, parkRegistry *allParks,
+    coldStore *cold, vehicle **cars, int count){
+
+    info *items[SNAPSHOTBATCH];
+    carHistory *histories[SNAPSHOTBATCH];
+    int car;
+
+    for (car = 0; car < count; car++)
+        __builtin_prefetch(getCarPastParked(cars[car]));
+    for (car = 0; car < count; car++){
+        items[car] = isCarCold(cars[car]) ? NULL :
+            getFirstItem(getCarPastParked(cars[car]));
+        if (items[car] != NULL) __builtin_prefetch(items[car]);
+    }
+    for (car = 0; car < count; car++){
+        histories[car] = items[car] == NULL ? NULL :
+            getCarHistoryInfo(items[car]);
+        if (histories[car] != NULL) __builtin_prefetch(histories[car]);
+    }
+    for (car = 0; car < count; car++)
+        if (histories[car] != NULL){
+            __builtin_prefetch(getCarHistoryTicket(histories[car], 0));
+            __builtin_prefetch(getCarHistoryName(histories[car]));
+        }
+
+    for (car = 0; car < count; car++)
+        if (isCarCold(cars[car])) putColdCar(writer, allParks, cold, cars[car]);
+        else putCar(writer, allParks, cars[car]);
+}
+
+/**
+ * @brief Adds the whole state to a snapshot, after its magic.
+ * @param writer A pointer to the snapshotWriter structure.
+ * @param allParks A pointer to the registry of all parks.
+ * @param allCars A pointer to the hash table of all cars.
+ * @param cold A pointer to the cold store, or NULL.
+ * @param globalTime The date and hour of the last log.
+ * @param journalBytes The bytes of the journal already in the snapshot.
+ * @param storeBytes The bytes of the history store already in the snapshot.
+ */
+static void putState(snapshotWriter *writer, parkRegistry *allParks,
+    hashTable *allCars, coldStore *cold, dateAndHour globalTime,
+    long journalBytes, long storeBytes){
+
+    unsigned int created = getRegistryCreated(allParks), position = 0;
+    int parkCount = getRegistryCount(allParks);
+    int carCount = getHashTableCount(allCars), batchCount = 0;
+    vehicle *car, *batch[SNAPSHOTBATCH];
+    info *parkItem;
+
+    putBytes(writer, &globalTime, sizeof(dateAndHour));
+    putBytes(writer, &journalBytes, sizeof(long));
+    putBytes(writer, &storeBytes, sizeof(long));
+    putBytes(writer, &created, sizeof(unsigned int));
+    putBytes(writer, &parkCount, sizeof(int));
+    putBytes(writer, &carCount, sizeof(int));
+
+    for (parkItem = getFirstItem(getRegistryParks(allParks));
+        parkItem != NULL; parkItem = getNextItem(parkItem))
+            putPark(writer, getParkInfo(parkItem));
+
+    while ((car = nextInHashTable(allCars, &position)) != NULL){
+        batch[batchCount++] = car;
+        if (batchCount == SNAPSHOTBATCH){
+            putCarBatch(writer, allParks, cold, batch, batchCount);
+            batchCount = 0;
+        }
+    }
+    putCarBatch(writer, allParks, cold, batch, batchCount);
+}
+
+long writeSnapshot(char *path, parkRegistry *allParks, hashTable *allCars,
+    historyStore *store, coldStore *cold, dateAndHour globalTime,
+    long journalBytes){
+
+    char *tempPath = (char*) malloc(strlen(path) + sizeof(".tmp"));
+    snapshotWriter *writer = (snapshotWriter*) malloc(sizeof(snapshotWriter));
+    unsigned long long checksum;
+    long size = -1;
+
+    strcpy(tempPath, path);
+    strcat(tempPath, ".tmp");
+    writer->fd = -1;
+    if (syncHistoryStore(store)) // its records are on the disk first
+        writer->fd = open(tempPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    writer->used = 0;
+    writer->size = 0;
+    writer->failed = writer->fd < 0;
+    writer->checksum = SNAPSHOTBASIS;
+
+    if (!writer->failed){
+        putBytes(writer, SNAPSHOTMAGIC, SNAPSHOTMAGICSIZE);
+        putState(writer, allParks, allCars, cold, globalTime, journalBytes,
+            getHistoryStoreNext(store));
+        flushSnapshot(writer);
+
+        checksum = writer->checksum; // the checksum is not in itself
+        putBytes(writer, &checksum, sizeof(checksum));
+        flushSnapshot(writer);
+
+        if (fsync(writer->fd) != 0) writer->failed = TRUE;
+        if (close(writer->fd) != 0) writer->failed = TRUE;
+        if (!writer->failed && rename(tempPath, path) == 0){
+            if (syncParentDirectory(path)) // or the rename may be lost
+                size = writer->size;
+        }
+        else unlink(tempPath);
+    }
+    free(writer);
+    free(tempPath);
+    return size;
+}
+
+/**
+ * @brief Copies the next field of a snapshot being read.
+ * @param reader A pointer to the snapshotReader structure.
+ * @param field Where the bytes are copied to.
+ * @param size The number of bytes.
+ * @return int: TRUE if the file had the bytes, FALSE otherwise.
+ */
+static int readSnapshotField(snapshotReader *reader, void *field,
+    size_t size){
+
+    if (reader->size - reader->position < size) return FALSE;
+    memcpy(field, reader->mapping + reader->position, size);
+    reader->position += size;
+    return TRUE;
+}
+
+/**
+ * @brief Gets the next array of a snapshot being read, after its alignment.
+ * @param reader A pointer to the snapshotReader structure.
+ * @param count The number of elements.
+ * @param elementSize The size of each element.
+ * @return void*: The array in the mapping, NULL if the file is too short.
+ */
+static void *readSnapshotArray(snapshotReader *reader, int count,
+    size_t elementSize){
+
+    char *array = reader->mapping + reader->position;
+
+    if (count < 0 || (reader->size - reader->position) / elementSize <
+        (size_t) count)
+            return NULL;
+    reader->position += elementSize * count;
+    return array;
+}
+
+/**
+ * @brief Skips the zeros before an array of a snapshot being read.
+ * @param reader A pointer to the snapshotReader structure.
+ */
+static void skipSnapshotAlignment(snapshotReader *reader){
+    reader->position = (reader->position + SNAPSHOTALIGN - 1) /
+        SNAPSHOTALIGN * SNAPSHOTALIGN;
+    if (reader->position > reader->size) reader->position = reader->size;
+}
+
+/**
+ * @brief Restores a park and its days of exits from a snapshot.
+ * @param reader A pointer to the snapshotReader structure.
+ * @param allParks A pointer to the registry of all parks.
+ * @param created The count of parks ever created.
+ * @return int: TRUE if the park was restored, FALSE if it is not valid.
+ */
+static int readPark(snapshotReader *reader, parkRegistry *allParks,
+    unsigned int created){
+
+    unsigned int number, nameLength;
+    int capacity, dayCount, day, exitCount;
+    millicents fees[3];
+    char *name = reader->mapping + reader->position;
+    exitVehicle *exits;
+    parkingLot *park;
+    date parkDate, lastDate = 0;
+
+    if (!readSnapshotField(reader, &number, sizeof(unsigned int)) ||
+        !readSnapshotField(reader, &capacity, sizeof(int)) ||
+        !readSnapshotField(reader, fees, sizeof(fees)) ||
+        !readSnapshotField(reader, &nameLength, sizeof(unsigned int)) ||
+        !readSnapshotField(reader, &dayCount, sizeof(int)) ||
+        (name = readSnapshotArray(reader, nameLength, sizeof(char))) == NULL)
+            return FALSE;
+
+    if (number >= created || searchParkByNumber(allParks, number) != NULL ||
+        nameLength == 0 ||
+        name[nameLength - 1] != '\0' || searchPark(allParks, name) != NULL ||
+        capacity <= 0 || isInvalidFee(fees[0], fees[1], fees[2]))
+            return FALSE;
+
+    park = createPark(name, capacity, fees[0], fees[1], fees[2]);
+    restorePark(allParks, park, number);
+
+    for (day = 0; day < dayCount; day++){
+        skipSnapshotAlignment(reader);
+        if (!readSnapshotField(reader, &parkDate, sizeof(date)) ||
+            !readSnapshotField(reader, &exitCount, sizeof(int)) ||
+            !isValidDate(parkDate) || parkDate <= lastDate ||
+            exitCount <= 0 || (exits = (exitVehicle*) readSnapshotArray(
+            reader, exitCount, sizeof(exitVehicle))) == NULL)
+                return FALSE;
+
+        restoreParkHistoryDay(park, restoreParkedCars(getParkArena(park),
+            parkDate, exits, exitCount));
+        lastDate = parkDate;
+    }
+    return TRUE;
+}
+
+/**
+ * @brief Restores a vehicle and its history sections from a snapshot.
+ * @param reader A pointer to the snapshotReader structure.
+ * @param allParks A pointer to the registry of all parks.
+ * @param allCars A pointer to the hash table of all cars.
+ * @return int: TRUE if the vehicle was restored, FALSE if it is not valid.
+ */
+static int readCar(snapshotReader *reader, parkRegistry *allParks,
+    hashTable *allCars){
+
+    plate registration;
+    unsigned int insidePark, sectionPark;
+    int lastSection, sectionCount, section, ticketCount, storedCount;
+    long lastStored;
+    dateAndHour lastSeen;
+    entryAndExit *tickets;
+    carHistory *carHist;
+    parkingLot *park = NULL;
+    vehicle *car;
+
+    skipSnapshotAlignment(reader);
+    if (!readSnapshotField(reader, &registration, sizeof(plate)) ||
+        !readSnapshotField(reader, &insidePark, sizeof(unsigned int)) ||
+        !readSnapshotField(reader, &lastSection, sizeof(int)) ||
+        !readSnapshotField(reader, &sectionCount, sizeof(int)) ||
+        !readSnapshotField(reader, &lastSeen, sizeof(dateAndHour)) ||
+        !isValidCarPlate(registration) ||
+        searchInHashTable(allCars, registration) != NULL ||
+        lastSection < -1 || lastSection >= sectionCount ||
+        (insidePark != SNAPSHOTNOPARK && ((park = searchParkByNumber(
+        allParks, insidePark)) == NULL || getParkFreeSpaces(park) == 0)))
+            return FALSE;
+
+    car = restoreCar(registration);
+    changeCarLastSeen(car, lastSeen);
+    addInHashTable(allCars, car);
+
+    for (section = 0; section < sectionCount; section++){
+        skipSnapshotAlignment(reader);
+        if (!readSnapshotField(reader, &lastStored, sizeof(long)) ||
+            !readSnapshotField(reader, &sectionPark, sizeof(unsigned int)) ||
+            !readSnapshotField(reader, &ticketCount, sizeof(int)) ||
+            !readSnapshotField(reader, &storedCount, sizeof(int)) ||
+            searchParkByNumber(allParks, sectionPark) == NULL ||
+            ticketCount < 0 || storedCount < 0 ||
+            ticketCount + storedCount == 0 ||
+            (storedCount == 0) != (lastStored == 0) || (lastStored != 0 &&
+            !isHistoryRecordOffset(reader->store, lastStored)))
+                return FALSE;
+
+        skipSnapshotAlignment(reader);
+        if ((tickets = (entryAndExit*) readSnapshotArray(reader, ticketCount,
+            sizeof(entryAndExit))) == NULL)
+                return FALSE;
+
+        carHist = restoreCarHistory(searchParkByNumber(allParks, sectionPark),
+            tickets, ticketCount);
+        changeCarHistoryStored(carHist, storedCount, lastStored);
+        restoreCarHistorySection(car, searchParkByNumber(allParks,
+            sectionPark), carHist);
+        if (section == lastSection) changeCarLastHistory(car, carHist);
+    }
+
+    if (park != NULL){
+        changeCarParkedParkName(car, getParkName(park));
+        addCarToPark(park, car);
+    }
+    return TRUE;
+}
+
+/**
+ * @brief Restores the whole state from a snapshot, after its magic.
+ * @param reader A pointer to the snapshotReader structure.
+ * @param allParks A pointer to the registry of all parks.
+ * @param allCars A pointer to the hash table of all cars.
+ * @param globalTime Where the date and hour of the last log is stored.
+ * @param journalBytes Where the bytes of the journal in the snapshot are
+ * stored.
+ * @return int: TRUE if the state was restored, FALSE if it is not valid.
+ */
+static int readState(snapshotReader *reader, parkRegistry *allParks,
+    hashTable *allCars, dateAndHour *globalTime, long *journalBytes){
+
+    long storeBytes;
+    unsigned int created;
+    int parkCount, carCount, count, valid = TRUE;
+
+    if (!readSnapshotField(reader, globalTime, sizeof(dateAndHour)) ||
+        !readSnapshotField(reader, journalBytes, sizeof(long)) ||
+        !readSnapshotField(reader, &storeBytes, sizeof(long)) ||
+        !changeHistoryStoreNext(reader->store, storeBytes) ||
+        !readSnapshotField(reader, &created, sizeof(unsigned int)) ||
+        !readSnapshotField(reader, &parkCount, sizeof(int)) ||
+        !readSnapshotField(reader, &carCount, sizeof(int)) ||
+        parkCount < 0 || (unsigned int) parkCount > created ||
+        carCount < 0 || (size_t) carCount > reader->size / SNAPSHOTMINCAR)
+            return FALSE;
+
+    reserveHashTable(allCars, carCount);
+    for (count = 0; valid && count < parkCount; count++)
+        valid = readPark(reader, allParks, created);
+    for (count = 0; valid && count < carCount; count++)
+        valid = readCar(reader, allParks, allCars);
+
+    changeRegistryCreated(allParks, created);
+    return valid && reader->position == reader->size;
+}
+
+int loadSnapshot(char *path, parkRegistry *allParks, hashTable *allCars,
+    historyStore *store, dateAndHour *globalTime, long *journalBytes){
+
+    snapshotReader reader;
+    struct stat fileStat;
+    unsigned long long checksum;
+    void *mapping;
+    int fd = open(path, O_RDONLY), result = SNAPSHOTINVALID;
+
+    if (fd < 0) return errno == ENOENT ? SNAPSHOTMISSING : SNAPSHOTINVALID;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size <
+        (off_t) (SNAPSHOTMAGICSIZE + sizeof(checksum))){
+            close(fd);
+            return SNAPSHOTINVALID;
+    }
+
+    mapping = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // the mapping stays valid
+    if (mapping == MAP_FAILED) return SNAPSHOTINVALID;
+    madvise(mapping, fileStat.st_size, MADV_SEQUENTIAL);
+
+    reader.mapping = (char*) mapping;
+    reader.size = fileStat.st_size - sizeof(checksum);
+    reader.position = SNAPSHOTMAGICSIZE;
+    reader.store = store;
+    memcpy(&checksum, reader.mapping + reader.size, sizeof(checksum));
+
+    if (memcmp(reader.mapping, SNAPSHOTMAGIC, SNAPSHOTMAGICSIZE) == 0 &&
+        checksum == addBlockToChecksum(SNAPSHOTBASIS, reader.mapping,
+        reader.size) &&
+        readState(&reader, allParks, allCars, globalTime, journalBytes))
+            result = SNAPSHOTLOADED;
+
+    munmap(mapping, fileStat.st_size);
+    return result;
+}
+
+/**
+ * @brief Gets the time of a monotonic clock.
+ * @return double: The time in milliseconds.
+ */
+static double getMilliseconds(){
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000.0 + now.tv_nsec / 1000000.0;
+}
+
+int startSnapshot(snapshotTask *task, char *path, parkRegistry *allParks,
+    hashTable *allCars, historyStore *store, coldStore *cold,
+    dateAndHour globalTime, long journalBytes){
+
+    int resultPipe[2];
+    double start;
+    long bytes;
+    pid_t child;
+
+    if (pipe(resultPipe) != 0) return FALSE;
+    start = getMilliseconds();
+    child = fork();
+    task->forkPause = getMilliseconds() - start;
+
+    if (child < 0){
+        close(resultPipe[0]);
+        close(resultPipe[1]);
+        return FALSE;
+    }
+    if (child == 0){ // the child writes its image and ends
+        close(resultPipe[0]);
+        bytes = writeSnapshot(path, allParks, allCars, store, cold,
+            globalTime, journalBytes);
+        if (write(resultPipe[1], &bytes, sizeof(long)) != sizeof(long))
+            _exit(1);
+        _exit(0); // without the buffers of the parent, or freeing anything
+    }
+
+    close(resultPipe[1]);
+    task->child = child;
+    task->resultFd = resultPipe[0];
+    task->bytes = -1;
+    return TRUE;
+}
+
+int finishSnapshot(snapshotTask *task, int wait){
+    pid_t ended;
+    long bytes;
+
+    do{
+        ended = waitpid(task->child, NULL, wait ? 0 : WNOHANG);
+    }while (ended < 0 && errno == EINTR);
+    if (ended == 0) return FALSE; // still writing
+
+    if (read(task->resultFd, &bytes, sizeof(long)) == sizeof(long))
+        task->bytes = bytes; // nothing is read if the child died
+    close(task->resultFd);
+    task->child = 0;
+    return TRUE;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file snapshot.h
+ * @brief This header file contains the declarations of the snapshots of the
+ * state, their writer and reader.
+ */
+
+// Check if the header file has already been included
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+// Include necessary libraries and header file
+#include <stddef.h>
+#include <sys/types.h>
+#include "dateAndHour.h"
+
+#define SNAPSHOTMAGIC "PKS4" /**< The first bytes of a snapshot file. */
+#define SNAPSHOTMAGICSIZE 4 /**< The number of bytes of the magic. */
+#define SNAPSHOTBUFFER 65536 /**< The size of the buffer of the writer. */
+#define SNAPSHOTALIGN 8 /**< The alignment of the arrays in the file. */
+#define SNAPSHOTSUFFIX ".snap" /**< Added to the journal path. */
+#define SNAPSHOTNOPARK 0xFFFFFFFFu /**< The park of a vehicle not parked. */
+#define SNAPSHOTBATCH 64 /**< The vehicles fetched together when written. */
+#define SNAPSHOTMINCAR 20 /**< The fewest bytes a vehicle takes in the file. */
+#define SNAPSHOTPOLL 1024 /**< Commands between checks of a checkpoint. */
+#define SNAPSHOTPRIME 1099511628211ull /**< The multiplier of the checksum.*/
+#define SNAPSHOTBASIS 14695981039346656037ull /**< The checksum of no bytes.*/
+
+// Define constants for the result of loading a snapshot
+#define SNAPSHOTLOADED 1
+#define SNAPSHOTMISSING 0
+#define SNAPSHOTINVALID -1
+
+// Forward declaration of structures
+typedef struct parkRegistry parkRegistry;
+typedef struct hashTable hashTable;
+typedef struct historyStore historyStore;
+typedef struct coldStore coldStore;
+
+/**
+ * @struct snapshotWriter
+ * @brief A structure to write a snapshot file through a buffer. The checksum
+ * is updated with each block written, in words of 8 bytes.
+ */
+typedef struct snapshotWriter{
+    int fd; /**< The file descriptor of the snapshot file. */
+    char buffer[SNAPSHOTBUFFER]; /**< The bytes not yet written. */
+    int used; /**< The number of bytes in the buffer. */
+    long size; /**< The number of bytes of the file, with the buffered ones. */
+    int failed; /**< TRUE if a write failed. */
+    unsigned long long checksum; /**< The checksum of the bytes written. */
+}snapshotWriter;
+
+/**
+ * @struct snapshotReader
+ * @brief A structure to read a snapshot file, mapped in memory. The arrays
+ * of the file are aligned to SNAPSHOTALIGN, so they are copied in one block
+ * from the mapping.
+ */
+typedef struct snapshotReader{
+    char *mapping; /**< The mapping of the file. */
+    size_t size; /**< The size of the file, without the checksum. */
+    size_t position; /**< The position of the next field. */
+    historyStore *store; /**< The history store of the stored tickets. */
+}snapshotReader;
+
+/**
+ * @struct snapshotTask
+ * @brief A structure to represent a checkpoint being written by a child
+ * process. The child has a copy-on-write image of the state as it was when
+ * forked, and sends the number of bytes it wrote through a pipe.
+ */
+typedef struct snapshotTask{
+    pid_t child; /**< The process writing the snapshot, 0 if there is none. */
+    int resultFd; /**< The end of the pipe where the child's result is read.*/
+    double forkPause; /**< The milliseconds the fork stopped the program. */
+    long bytes; /**< The bytes written by the child, -1 if it failed. */
+}snapshotTask;
+
+/**
+ * @brief Writes a snapshot of the whole state to a file.
+ * The snapshot has the global time, the parks with their days of exits and
+ * the vehicles with their history sections. Parks are referred to by their
+ * number, and the tickets in the history store by their offset, so they are
+ * not copied. The vehicles evicted to the cold store are written in full,
+ * from their segments, since that store only lives while the program runs.
+ * The store is synced first, and the file is written under a temporary
+ * name, synced and renamed, and the directory is synced, so a crash leaves
+ * the previous snapshot whole and the journal is never trusted to a lost
+ * rename.
+ * @param path The path of the snapshot file.
+ * @param allParks A pointer to the registry of all parks.
+ * @param allCars A pointer to the hash table of all cars.
+ * @param store A pointer to the history store.
+ * @param cold A pointer to the cold store, or NULL.
+ * @param globalTime The date and hour of the last log.
+ * @param journalBytes The bytes of the journal already in the snapshot.
+ * @return long: The number of bytes written, -1 if the file could not be
+ * written.
+ */
+long writeSnapshot(char *path, parkRegistry *allParks, hashTable *allCars,
+    historyStore *store, coldStore *cold, dateAndHour globalTime,
+    long journalBytes);
+
+/**
+ * @brief Restores the state saved in a snapshot file.
+ * The file is mapped in memory and its checksum checked before any structure
+ * is created. The arrays of exits and tickets are copied in one block each,
+ * and the park numbers of the file are fixed up into pointers. The tickets
+ * in the history store stay there, and the store goes on after the records
+ * the snapshot covers.
+ * @param path The path of the snapshot file.
+ * @param allParks A pointer to the empty registry of all parks.
+ * @param allCars A pointer to the empty hash table of all cars.
+ * @param store A pointer to the history store.
+ * @param globalTime Where the date and hour of the last log is stored.
+ * @param journalBytes Where the bytes of the journal in the snapshot are
+ * stored.
+ * @return int: SNAPSHOTLOADED, SNAPSHOTMISSING if the file does not exist,
+ * or SNAPSHOTINVALID if it is not a valid snapshot.
+ */
+int loadSnapshot(char *path, parkRegistry *allParks, hashTable *allCars,
+    historyStore *store, dateAndHour *globalTime, long *journalBytes);
+
+/**
+ * @brief Starts writing a snapshot of the whole state in a child process.
+ * The program only stops for the fork, which copies the page tables and
+ * not the memory, and goes on changing its own pages while the child writes
+ * the frozen ones with writeSnapshot.
+ * @param task A pointer to the snapshotTask structure, without a child.
+ * @param path The path of the snapshot file.
+ * @param allParks A pointer to the registry of all parks.
+ * @param allCars A pointer to the hash table of all cars.
+ * @param store A pointer to the history store.
+ * @param cold A pointer to the cold store, or NULL.
+ * @param globalTime The date and hour of the last log.
+ * @param journalBytes The bytes of the journal already in the snapshot.
+ * @return int: TRUE if the child was started, FALSE if the fork failed.
+ */
+int startSnapshot(snapshotTask *task, char *path, parkRegistry *allParks,
+    hashTable *allCars, historyStore *store, coldStore *cold,
+    dateAndHour globalTime, long journalBytes);
+
+/**
+ * @brief Checks if the child of a snapshot has ended and collects it.
+ * @param task A pointer to the snapshotTask structure, with a child.
+ * @param wait TRUE to wait for the child to end, FALSE to only check.
+ * @return int: TRUE if the child ended, its bytes are then in the task,
+ * FALSE if it is still writing.
+ */
+int finishSnapshot(snapshotTask *task, int wait);
+
+#endif
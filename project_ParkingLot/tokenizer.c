@@ -0,0 +1,82 @@
+/**
+ * @file tokenizer.c
+ * @brief This file contains the implementation of the command tokenizer.
+ */
+
+// Include necessary header file
+#include "tokenizer.h"
+
+/**
+ * @brief Checks if a character ends a command line.
+ * @param letter The character to check.
+ * @return int: Non zero if the character ends the line, 0 otherwise.
+ */
+static int isEndOfLine(char letter){
+    return letter == '\0' || letter == '\n' || letter == '\r';
+}
+
+char *nextToken(char **cursor){
+    char *start = *cursor, *end;
+
+    while (*start == ' ' || *start == '\t') start++;
+
+    if (isEndOfLine(*start)){ // no more tokens, the line ends here
+        *start = '\0';
+        *cursor = start;
+        return start;
+    }
+    if (*start == '\"'){ // quoted name, may contain spaces
+        start++;
+        for (end = start; *end != '\"' && !isEndOfLine(*end); end++);
+    }
+    else
+        for (end = start; *end != ' ' && *end != '\t' && !isEndOfLine(*end);
+            end++);
+
+    // keep the cursor on the terminator if the line ends after the token
+    *cursor = isEndOfLine(*end) ? end : end + 1;
+    *end = '\0';
+    return start;
+}
+
+int hasMoreTokens(char *cursor){
+    while (*cursor == ' ' || *cursor == '\t') cursor++;
+    return !isEndOfLine(*cursor);
+}
+
+int tokenToInt(char *token){
+    int value = 0, sign = 1;
+
+    if (*token == '-' || *token == '+'){
+        if (*token == '-') sign = -1;
+        token++;
+    }
+    for (; *token >= '0' && *token <= '9'; token++)
+        if (value < MAXTOKENINT) value = value * 10 + (*token - '0');
+
+    return sign * value;
+}
+
+millicents tokenToMillicents(char *token){
+    millicents value = 0, decimals;
+    int sign = 1;
+
+    if (*token == '-' || *token == '+'){
+        if (*token == '-') sign = -1;
+        token++;
+    }
+    for (; *token >= '0' && *token <= '9'; token++)
+        if (value < MAXTOKENAMOUNT) value = value * 10 + (*token - '0');
+
+    value *= 100 * MILLICENTSINCENT;
+    if (*token == '.'){
+        token++;
+        for (decimals = 10 * MILLICENTSINCENT; decimals > 0 &&
+            *token >= '0' && *token <= '9'; decimals /= 10, token++)
+                value += decimals * (*token - '0');
+
+        if (decimals == 0 && *token >= '5' && *token <= '9')
+            value++; // the sixth decimal rounds to the nearest millicent
+    }
+    return sign * value;
+}
@@ -0,0 +1,56 @@
+/**
+ * @file tokenizer.h
+ * @brief This header file contains the declarations of the command tokenizer
+ * functions.
+ */
+
+// Check if the header file has already been included
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+// Include header file
+#include "dateAndHour.h"
+
+#define MAXTOKENINT 100000000 /**< Integers above this stop growing. */
+#define MAXTOKENAMOUNT 10000000LL /**< Amounts above this stop growing. */
+
+/**
+ * @brief Reads the next token of a command line.
+ * This function skips the blanks before the token and terminates the token in
+ * place, so the returned pointer is a slice of the line itself and nothing is
+ * copied. A token that starts with a double quote ends at the closing quote
+ * and may contain spaces, the quotes are not part of the token. When the line
+ * has no more tokens an empty token is returned.
+ * @param cursor A pointer to the current position in the line. It is moved
+ * past the token that was read.
+ * @return char*: The token read, an empty string if the line has ended.
+ */
+char *nextToken(char **cursor);
+
+/**
+ * @brief Checks if a command line has tokens after a position.
+ * @param cursor The position in the line.
+ * @return int: Non zero if there is another token, 0 otherwise.
+ */
+int hasMoreTokens(char *cursor);
+
+/**
+ * @brief Converts a token to an integer.
+ * This function reads an optional sign followed by decimal digits. Any other
+ * character ends the number.
+ * @param token The token to convert.
+ * @return int: The integer read, 0 if the token has no digits.
+ */
+int tokenToInt(char *token);
+
+/**
+ * @brief Converts a token with a fee to thousandths of a cent.
+ * This function reads an optional sign, the integer digits and the decimals
+ * after a point. Up to 5 decimals are kept exactly, the sixth rounds the fee
+ * to the nearest thousandth of a cent and the following ones are ignored.
+ * @param token The token to convert.
+ * @return millicents: The fee read, 0 if the token has no digits.
+ */
+millicents tokenToMillicents(char *token);
+
+#endif
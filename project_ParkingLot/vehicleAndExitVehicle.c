@@ -7,33 +7,196 @@
 
 // Include necessary libraries and header files.
 #include <stdlib.h>
-#include <string.h>
-#include <ctype.h>
 #include "vehicleAndExitVehicle.h"
 
-vehicle* createCar(char* identifer, dateAndHour *entryTime, char* parkName){
+/**
+ * @brief Gets the key of a history section in the index of a vehicle.
+ * @param historyItem The item of the section.
+ * @return unsigned int: The number of the park of the section plus 1.
+ */
+static unsigned int sectionKey(info *historyItem){
+    carHistory *carHist = getCarHistoryInfo(historyItem);
+
+    return getParkNumber(getCarHistoryPark(carHist)) + 1;
+}
+
+/**
+ * @brief Puts a history section in the first free slot of its probe in the
+ * index of a vehicle. The section must not be in the index.
+ * @param car A pointer to the vehicle structure.
+ * @param historyItem The item of the section.
+ */
+static void placeSection(vehicle *car, info *historyItem){
+    unsigned int key = sectionKey(historyItem), mask = car->sectionSize - 1;
+    unsigned int slot = key & mask; // park numbers are spread already
+
+    while (car->sections[slot].item != NULL) slot = (slot + 1) & mask;
+    if (car->sections[slot].key == 0) car->sectionsUsed++;
+    car->sections[slot].key = key;
+    car->sections[slot].item = historyItem;
+}
+
+/**
+ * @brief Builds again the index of the history sections of a vehicle.
+ * The index gets at least 4 slots for each section, without deleted ones.
+ * @param car A pointer to the vehicle structure.
+ */
+static void buildSectionIndex(vehicle *car){
+    unsigned int size = 1;
+    info *item;
+
+    while (size < 4 * (unsigned int) getListSize(getCarPastParked(car)))
+        size *= 2;
+    free(car->sections);
+    car->sections = (sectionSlot*) calloc(size, sizeof(sectionSlot));
+    car->sectionSize = size;
+    car->sectionsUsed = 0;
+
+    for (item = getFirstItem(getCarPastParked(car)); item != NULL;
+        item = getNextItem(item))
+            placeSection(car, item);
+}
+
+/**
+ * @brief Adds a history section already in the history of a vehicle to its
+ * index. The index is built once the vehicle has more than CARINDEXSECTIONS
+ * sections, and grows when half of its slots are used.
+ * @param car A pointer to the vehicle structure.
+ * @param historyItem The item of the section.
+ */
+static void indexSection(vehicle *car, info *historyItem){
+    if (car->sections == NULL){
+        if (getListSize(getCarPastParked(car)) > CARINDEXSECTIONS)
+            buildSectionIndex(car);
+    }
+    else if ((car->sectionsUsed + 1) * 2 > car->sectionSize)
+        buildSectionIndex(car);
+    else
+        placeSection(car, historyItem);
+}
+
+/**
+ * @brief Marks the slot of a history section in the index of a vehicle as
+ * deleted.
+ * @param car A pointer to the vehicle structure.
+ * @param historyItem The item of the section.
+ */
+static void unindexSection(vehicle *car, info *historyItem){
+    unsigned int mask = car->sectionSize - 1, slot;
+
+    if (car->sections == NULL) return;
+    for (slot = sectionKey(historyItem) & mask; car->sections[slot].key != 0;
+        slot = (slot + 1) & mask)
+            if (car->sections[slot].item == historyItem){
+                car->sections[slot].item = NULL; // the key marks it deleted
+                return;
+            }
+}
+
+/**
+ * @brief Searches for the history section of a vehicle in a parking lot.
+ * @param car A pointer to the vehicle structure.
+ * @param park The parking lot.
+ * @return info*: The item of the section, NULL if there is none.
+ */
+static info *searchCarHistorySection(vehicle *car, parkingLot *park){
+    unsigned int key = getParkNumber(park) + 1, mask = car->sectionSize - 1;
+    unsigned int slot;
+
+    if (car->sections == NULL) // few sections, they are gone through
+        return searchForItem(getCarPastParked(car), getParkName(park));
+
+    for (slot = key & mask; car->sections[slot].key != 0;
+        slot = (slot + 1) & mask)
+            if (car->sections[slot].key == key &&
+                car->sections[slot].item != NULL)
+                    return car->sections[slot].item;
+    return NULL;
+}
+
+/**
+ * @brief Frees the index of the history sections of a vehicle.
+ * @param car A pointer to the vehicle structure.
+ */
+static void freeSectionIndex(vehicle *car){
+    free(car->sections);
+    car->sections = NULL;
+    car->sectionSize = 0;
+    car->sectionsUsed = 0;
+}
+
+/**
+ * @brief Creates the history section of a vehicle in a parking lot.
+ * The section is taken from the arena of the lot, starts with an entry, is
+ * added to the vehicle's history and the vehicle to the visitors of the lot.
+ * @param car A pointer to the vehicle structure.
+ * @param time The date and hour of vehicle entry.
+ * @param park The parking lot.
+ */
+static void addCarHistorySection(vehicle *car, dateAndHour time,
+    parkingLot *park){
+
+    info *historyItem;
+
+    car->lastHistory = createCarHistory(park, time);
+    car->lastTicket = getCarHistoryLastTicket(car->lastHistory);
+
+    historyItem = createInfo(car->lastHistory, ISCARHISTORY);
+    addItemInOrder(getCarPastParked(car), historyItem);
+    indexSection(car, historyItem);
+    addParkVisitor(park, car, historyItem);
+}
+
+vehicle* createCar(plate identifer, dateAndHour entryTime, parkingLot *park){
     vehicle *newCar = (vehicle*) malloc(sizeof(vehicle));
 
-    strcpy(newCar->registration, identifer);
-    newCar->insidePark = parkName;
+    newCar->registration = identifer;
+    newCar->lastSeen = entryTime;
+    newCar->insidePark = getParkName(park);
+    newCar->parkedItem = NULL;
     newCar-> pastParked = createList();
+    newCar->sections = NULL;
+    newCar->sectionSize = 0;
+    newCar->sectionsUsed = 0;
+    newCar->coldSegment = 0;
+    addCarHistorySection(newCar, entryTime, park);
+
+    return newCar;
+}
 
-    addItemInOrder(newCar->pastParked,
-        createInfo(createCarHistory(entryTime, parkName), ISCARHISTORY));
+vehicle *restoreCar(plate identifier){
+    vehicle *newCar = (vehicle*) malloc(sizeof(vehicle));
 
+    newCar->registration = identifier;
+    newCar->lastSeen = 0;
+    newCar->insidePark = NULL;
+    newCar->parkedItem = NULL;
+    newCar->pastParked = createList();
+    newCar->sections = NULL;
+    newCar->sectionSize = 0;
+    newCar->sectionsUsed = 0;
+    newCar->lastHistory = NULL;
+    newCar->lastTicket = NULL;
+    newCar->coldSegment = 0;
     return newCar;
 }
 
-exitVehicle* createExitVehicle(vehicle *car, hours *logHours, double fee){
-    exitVehicle *newExit = (exitVehicle*) malloc(sizeof(exitVehicle));
+void restoreCarHistorySection(vehicle *car, parkingLot *park,
+    carHistory *carHist){
+
+    info *historyItem = createInfo(carHist, ISCARHISTORY);
 
-    newExit-> car = car;
-    newExit-> exitHours = logHours;
-    newExit-> payment = fee;
-    return newExit;
+    addItem(getCarPastParked(car), historyItem); // the history is in order
+    indexSection(car, historyItem);
+    addParkVisitor(park, car, historyItem);
 }
 
-char* getCarRegistration(vehicle *car){
+void changeCarLastHistory(vehicle *car, carHistory *carHist){
+    car->lastHistory = carHist;
+    car->lastTicket = carHist == NULL ? NULL : getCarHistoryLastTicket(carHist);
+}
+
+plate getCarRegistration(vehicle *car){
     return car->registration;
 }
 
@@ -45,80 +208,169 @@ list* getCarPastParked(vehicle *car){
     return car->pastParked;
 }
 
-vehicle* getExitVehicleCar(exitVehicle *exit){
-    return exit->car;
+plate getExitVehiclePlate(exitVehicle *exit){
+    return exit->registration;
 }
 
-hours *getExitVehicleExitTime(exitVehicle *exit){
+hours getExitVehicleExitTime(exitVehicle *exit){
     return exit->exitHours;
 }
 
-double getExitVehiclePayment(exitVehicle *exit){
+cents getExitVehiclePayment(exitVehicle *exit){
     return exit->payment;
 }
 
-dateAndHour *getCarLastEntryTime(vehicle *car){
-    info *carHistorySection = searchForItem(getCarPastParked(car),
-        getCarParkedParkName(car));
+carHistory *getCarLastHistory(vehicle *car){
+    return car->lastHistory;
+}
+
+dateAndHour getCarLastEntryTime(vehicle *car){
+    return getEntry(car->lastTicket);
+}
 
-    return getCarHistoryLastEntry(getCarHistoryInfo(carHistorySection));
+dateAndHour getCarLastSeen(vehicle *car){
+    return car->lastSeen;
 }
 
-void changeCarParkedParkName(vehicle *car, char *parkName){
-    car->insidePark = parkName;
+void changeCarLastSeen(vehicle *car, dateAndHour time){
+    car->lastSeen = time;
 }
 
-void putNewEntryInCar(vehicle *car, dateAndHour *time, char* parkName){
-    info* carHistorySection = searchForItem(getCarPastParked(car), parkName);
+int isCarCold(vehicle *car){
+    return car->coldSegment != 0;
+}
 
-    if (carHistorySection == NULL){ // don't have a history in this park
-        carHistorySection = createInfo(
-            createCarHistory(time, parkName), ISCARHISTORY);
+long getCarColdSegment(vehicle *car){
+    return car->coldSegment;
+}
 
-        addItemInOrder(getCarPastParked(car), carHistorySection);
+void evictCarHistory(vehicle *car, long segment){
+    info *item;
+    carHistory *carHist;
+
+    for (item = getFirstItem(getCarPastParked(car)); item != NULL;
+        item = getNextItem(item)){
+
+        carHist = getCarHistoryInfo(item);
+        removeParkVisitor(getCarHistoryPark(carHist),
+            getCarHistoryVisitor(carHist));
+        freeCarHistory(carHist);
     }
-    else
-        putNewEntryInCarHistory(getCarHistoryInfo(carHistorySection), time);
+    shallowFreeList(getCarPastParked(car));
+    freeSectionIndex(car);
+
+    car->pastParked = NULL;
+    car->lastHistory = NULL;
+    car->lastTicket = NULL;
+    car->coldSegment = segment;
+}
+
+void reloadCarHistory(vehicle *car){
+    car->pastParked = createList();
+    car->coldSegment = 0;
 }
 
-void putNewExitInCar(vehicle *car, dateAndHour *time, double fee){
-    info *carHistorySection = searchForItem(getCarPastParked(car),
-        getCarParkedParkName(car));
+long getCarResidentBytes(vehicle *car){
+    long bytes = sizeof(vehicle);
+    info *item;
 
-    putNewExitInCarHistory(getCarHistoryInfo(carHistorySection), time, fee);
+    if (isCarCold(car)) return bytes;
+    bytes += sizeof(list) + sizeof(sectionSlot) * car->sectionSize;
+    for (item = getFirstItem(getCarPastParked(car)); item != NULL;
+        item = getNextItem(item))
+            bytes += sizeof(info) + sizeof(parkVisitor) +
+                getCarHistoryBytes(getCarHistoryInfo(item));
+    return bytes;
 }
 
-int minutesParked(vehicle *car, dateAndHour *exitTime){
-    dateAndHour *entryTime = getCarLastEntryTime(car);
+info *getCarParkedItem(vehicle *car){
+    return car->parkedItem;
+}
 
-    return differenceInMinutes(exitTime, entryTime);
+void changeCarParkedItem(vehicle *car, info *item){
+    car->parkedItem = item;
 }
 
-int isCarParked(vehicle *car){
-    return getCarParkedParkName(car) != NULL;
+void changeCarParkedParkName(vehicle *car, char *parkName){
+    car->insidePark = parkName;
 }
 
-int isValidCarPlate(char *carPlate){
-    int pos = 0, hasNumbers = FALSE, hasLetters = FALSE; // pos->position
+void putNewEntryInCar(vehicle *car, dateAndHour time, parkingLot *park){
+    carHistory *carHist = getCarLastHistory(car);
+    info *carHistorySection;
 
-    for(pos = 0; pos <= 6; pos += 3){ // carPlate is like : xx-xx-xx\0
-        if (isdigit(*(carPlate + pos)) && isdigit(*(carPlate + pos + 1)))
-            hasNumbers = TRUE;
+    car->lastSeen = time;
 
-        else if (isupper(*(carPlate + pos)) && isupper(*(carPlate + pos + 1)))
-            hasLetters = TRUE;
+    // park names are not copied, the same park has the same name pointer
+    if (carHist == NULL || getCarHistoryName(carHist) != getParkName(park)){
+        carHistorySection = searchCarHistorySection(car, park);
 
-        else return FALSE;
+        if (carHistorySection == NULL){ // don't have a history in this park
+            addCarHistorySection(car, time, park);
+            return;
+        }
+        carHist = getCarHistoryInfo(carHistorySection);
     }
-    return hasNumbers && hasLetters; // FALSE if it has 3 equal type of pairs
+    car->lastHistory = carHist;
+    car->lastTicket = putNewEntryInCarHistory(carHist, time);
+}
+
+void putNewExitInCar(vehicle *car, dateAndHour time, cents fee){
+    putExitInTicket(car->lastTicket, time, fee);
+    car->lastSeen = time;
+}
+
+void storeCarLastTicket(vehicle *car, historyStore *store, unsigned int park,
+    long journalOffset){
+
+    historyRecord record;
+    long offset;
+
+    record.previous = getCarHistoryLastStored(car->lastHistory);
+    record.journalOffset = journalOffset;
+    record.registration = car->registration;
+    record.park = park;
+    record.entry = getEntry(car->lastTicket);
+    record.exit = getExit(car->lastTicket);
+    record.fee = getPayedFee(car->lastTicket);
+
+    if ((offset = addHistoryRecord(store, &record)) < 0) return;
+    moveLastTicketToStore(car->lastHistory, offset);
+    car->lastTicket = NULL;
+}
+
+long long minutesParked(vehicle *car, dateAndHour exitTime){
+    dateAndHour entryTime = getCarLastEntryTime(car);
+
+    return differenceInMinutes(exitTime, entryTime);
+}
+
+void removeCarHistoryInPark(vehicle *car, info *historyItem){
+    carHistory *carHist = getCarHistoryInfo(historyItem);
+
+    unindexSection(car, historyItem);
+    unlinkItem(getCarPastParked(car), historyItem);
+    if (carHist == getCarLastHistory(car)){
+        car->lastHistory = NULL;
+        car->lastTicket = NULL;
+    }
+
+    // park names are not copied, the same park has the same name pointer
+    if (getCarParkedParkName(car) == getCarHistoryName(carHist)){
+        changeCarParkedParkName(car, NULL);
+        changeCarParkedItem(car, NULL);
+    }
+    freeInfoItem(historyItem);
+}
+
+int isCarParked(vehicle *car){
+    return getCarParkedParkName(car) != NULL;
 }
 
 void freeCar(vehicle *car){
-    freeList(getCarPastParked(car));
+    if (!isCarCold(car)) // the sections are in the arenas
+        shallowFreeList(getCarPastParked(car));
+    free(car->sections);
     free(car);
 }
 
-void freeExitVehicle(exitVehicle *exit){
-    free(getExitVehicleExitTime(exit));
-    free(exit);
-}
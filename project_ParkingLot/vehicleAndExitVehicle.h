@@ -13,30 +13,68 @@
 // Include header file
 #include "project.h"
 
-#define CARPLATE 9 /**< Carplate length -> XX-XX-XX\0 */
+// Forward declaration of structures
+typedef struct info info;
+typedef struct carHistory carHistory;
+typedef struct entryAndExit entryAndExit;
+typedef struct parkingLot parkingLot;
+typedef struct historyStore historyStore;
+
+#define CARINDEXSECTIONS 8 /**< The sections of a vehicle without an index. */
+
+/**
+ * @struct sectionSlot
+ * @brief A structure to represent a slot of the index of the history
+ * sections of a vehicle. A slot with an item is in use. A slot without an
+ * item is empty if its key is 0, or deleted otherwise, searches don't stop on
+ * deleted slots.
+ */
+typedef struct sectionSlot{
+    unsigned int key; /**< The number of the park of the section plus 1. */
+    struct info *item; /**< The item of the section in the history. */
+}sectionSlot;
 
 /**
  * @struct vehicle
  * @brief A structure to represent a vehicle. This structure represents a
  * vehicle with its registration, the park it is currently in, and its
- * parking history.
+ * parking history. A vehicle with more than CARINDEXSECTIONS history
+ * sections also keeps an open addressing index of them by park number, with
+ * linear probing, so the section of a park is found without going through
+ * the history. When the history is evicted to the cold store, only the
+ * registration, the time it was last seen and its segment are kept.
  */
 typedef struct vehicle{
-    char registration[CARPLATE]; /**< The vehicle's registration. */
+    plate registration; /**< The vehicle's registration. */
+    dateAndHour lastSeen; /**< The date and hour of its last entry or exit. */
     char* insidePark; /**< The name of the park the vehicle is currently in. */
-    struct list *pastParked; /**< A list of the vehicle's parking history. */
+    struct info *parkedItem; /**< The vehicle's item in the list of cars of
+        that park, NULL if it is not parked. */
+    struct carHistory *lastHistory; /**< The history section of the park of
+        the last entry, NULL if it was removed. */
+    struct entryAndExit *lastTicket; /**< The log of the last entry, still
+        open while the vehicle is parked. */
+    struct list *pastParked; /**< A list of the vehicle's parking history,
+        NULL if it was evicted. */
+    sectionSlot *sections; /**< The slots of the index of the history, NULL
+        while there is no index. */
+    unsigned int sectionSize; /**< The number of slots, a power of 2. */
+    unsigned int sectionsUsed; /**< The count of slots in use or deleted. */
+    long coldSegment; /**< The offset of the segment of the history in the
+        cold store, 0 if it is in memory. */
 }vehicle;
 
 /**
  * @struct exitVehicle
  * @brief A structure to represent a vehicle that has exited a park.
- * This structure represents a vehicle that has exited a park, with its vehicle
- * information, exit time, and payment.
+ * This structure represents a vehicle that has exited a park, with its
+ * registration, exit time, and payment. The exits of a day are stored by
+ * value in the parkedCars structure of that day.
  */
 typedef struct exitVehicle{
-    vehicle *car; /**< A pointer to the vehicle information. */
-    hours *exitHours; /**< The time the vehicle exited the park. */
-    double payment; /**< The payment made by the vehicle. */
+    plate registration; /**< The registration of the vehicle. */
+    hours exitHours; /**< The time the vehicle exited the park. */
+    cents payment; /**< The payment made by the vehicle. */
 } exitVehicle;
 
 /**
@@ -46,29 +84,45 @@ typedef struct exitVehicle{
  * history and adds an entry for the current parking.
  * @param identifier The vehicle's registration identifier.
  * @param entryTime The date and hour of vehicle entry.
- * @param parkName The name of the parking lot.
+ * @param park The parking lot.
+ * @return vehicle*: A pointer to the created vehicle structure.
+ */
+vehicle *createCar(plate identifier, dateAndHour entryTime, parkingLot *park);
+
+/**
+ * @brief Creates a vehicle structure without history, to restore a saved one.
+ * The vehicle is not parked, its history sections are added with
+ * restoreCarHistorySection.
+ * @param identifier The vehicle's registration identifier.
  * @return vehicle*: A pointer to the created vehicle structure.
  */
-vehicle *createCar(char *identifier, dateAndHour *entryTime, char *parkName);
+vehicle *restoreCar(plate identifier);
 
 /**
- * @brief Creates a new exitVehicle structure.
- * This function allocates memory for a new exitVehicle structure and
- * initializes it with the given parameters. The exitVehicle structure
- * represents a vehicle that has exited the parking lot.
+ * @brief Adds a saved history section to the end of a vehicle's history.
+ * The sections must be restored in the order of the history, and the vehicle
+ * is added to the visitors of the parking lot.
  * @param car A pointer to the vehicle structure.
- * @param logHours The time of vehicle exit.
- * @param fee The fee for parking.
- * @return exitVehicle*: A pointer to the created exitVehicle structure.
+ * @param park The parking lot of the section.
+ * @param carHist The history section.
+ */
+void restoreCarHistorySection(vehicle *car, parkingLot *park,
+    carHistory *carHist);
+
+/**
+ * @brief Changes the history section of the park of the vehicle's last entry.
+ * The last entry of that section is kept as the vehicle's last entry.
+ * @param car A pointer to the vehicle structure.
+ * @param carHist The history section, NULL if it was removed.
  */
-exitVehicle *createExitVehicle(vehicle *car, hours *logHours, double fee);
+void changeCarLastHistory(vehicle *car, carHistory *carHist);
 
 /**
  * @brief Retrieves the registration of a vehicle.
  * @param car A pointer to the vehicle structure.
- * @return char*: The registration of the vehicle.
+ * @return plate: The registration of the vehicle.
  */
-char* getCarRegistration(vehicle *car);
+plate getCarRegistration(vehicle *car);
 
 /**
  * @brief Retrieves the name of the parking lot where the vehicle is parked.
@@ -85,32 +139,107 @@ char* getCarParkedParkName(vehicle *car);
 list* getCarPastParked(vehicle *car);
 
 /**
- * @brief Retrieves the vehicle associated with an exit record.
+ * @brief Retrieves the registration of the vehicle of an exit record.
  * @param exit A pointer to the exitVehicle structure.
- * @return vehicle*: A pointer to the vehicle structure.
+ * @return plate: The registration of the vehicle.
  */
-vehicle *getExitVehicleCar(exitVehicle *exit);
+plate getExitVehiclePlate(exitVehicle *exit);
 
 /**
  * @brief Retrieves the exit time from an exit record.
  * @param exit A pointer to the exitVehicle structure.
- * @return hours*: The exit time of the vehicle.
+ * @return hours: The exit time of the vehicle.
  */
-hours* getExitVehicleExitTime(exitVehicle *exit);
+hours getExitVehicleExitTime(exitVehicle *exit);
 
 /**
  * @brief Retrieves the payment from an exit record.
  * @param exit A pointer to the exitVehicle structure.
- * @return double: The payment made by the vehicle.
+ * @return cents: The payment made by the vehicle.
  */
-double getExitVehiclePayment(exitVehicle *exit);
+cents getExitVehiclePayment(exitVehicle *exit);
+
+/**
+ * @brief Retrieves the history section of the park of the last entry.
+ * @param car A pointer to the vehicle structure.
+ * @return carHistory*: The history section, NULL if its park was removed.
+ */
+carHistory *getCarLastHistory(vehicle *car);
 
 /**
  * @brief Retrieves the last entry time of a vehicle.
  * @param car A pointer to the vehicle structure.
- * @return dateAndHour*: The last entry time of the vehicle.
+ * @return dateAndHour: The last entry time of the vehicle.
+ */
+dateAndHour getCarLastEntryTime(vehicle *car);
+
+/**
+ * @brief Retrieves the date and hour a vehicle was last seen.
+ * @param car A pointer to the vehicle structure.
+ * @return dateAndHour: The time of its last entry or exit, or of the last
+ * time its history was loaded from the cold store.
+ */
+dateAndHour getCarLastSeen(vehicle *car);
+
+/**
+ * @brief Changes the date and hour a vehicle was last seen.
+ * @param car A pointer to the vehicle structure.
+ * @param time The new date and hour.
+ */
+void changeCarLastSeen(vehicle *car, dateAndHour time);
+
+/**
+ * @brief Checks if the history of a vehicle was evicted to the cold store.
+ * @param car A pointer to the vehicle structure.
+ * @return int: TRUE if the history is in the cold store, FALSE otherwise.
+ */
+int isCarCold(vehicle *car);
+
+/**
+ * @brief Retrieves the segment of the history of a vehicle in the cold store.
+ * @param car A pointer to the vehicle structure.
+ * @return long: The offset of the segment, 0 if the history is in memory.
+ */
+long getCarColdSegment(vehicle *car);
+
+/**
+ * @brief Frees the history of a vehicle, once it is in the cold store.
+ * The history sections are given back to the arenas of their parks and
+ * removed from their visitors, and the list of the history is freed. The
+ * vehicle must not be parked.
+ * @param car A pointer to the vehicle structure.
+ * @param segment The offset of the segment with the history.
+ */
+void evictCarHistory(vehicle *car, long segment);
+
+/**
+ * @brief Gives a vehicle evicted to the cold store an empty history again.
+ * The sections of its segment are then added with restoreCarHistorySection.
+ * @param car A pointer to the vehicle structure.
+ */
+void reloadCarHistory(vehicle *car);
+
+/**
+ * @brief Calculates the bytes a vehicle and its history take in memory.
+ * @param car A pointer to the vehicle structure.
+ * @return long: The bytes of the vehicle, and of its list, items, sections
+ * with their tickets and visitors if it is not evicted.
  */
-dateAndHour* getCarLastEntryTime(vehicle *car);
+long getCarResidentBytes(vehicle *car);
+
+/**
+ * @brief Retrieves the item of the vehicle in the cars of its parking lot.
+ * @param car A pointer to the vehicle structure.
+ * @return info*: The item of the vehicle, NULL if it is not parked.
+ */
+info *getCarParkedItem(vehicle *car);
+
+/**
+ * @brief Changes the item of the vehicle in the cars of its parking lot.
+ * @param car A pointer to the vehicle structure.
+ * @param item The new item of the vehicle, NULL if it left the parking lot.
+ */
+void changeCarParkedItem(vehicle *car, info *item);
 
 /**
  * @brief Changes the name of the parking lot where the vehicle is parked.
@@ -121,34 +250,51 @@ void changeCarParkedParkName(vehicle *car, char *parkName);
 
 /**
  * @brief Adds a new entry record to a vehicle's history.
- * This function searches for the car's history in the specified parking lot.
- * If it doesn't exist, it creates a new carHistory and adds it to the car's
- * history. Then, it adds a new entry record to the carHistory.
+ * If the car's last entry was in the same parking lot its history section is
+ * used, otherwise this function searches for the car's history in the
+ * specified parking lot. If it doesn't exist, it creates a new carHistory in
+ * the arena of the lot, adds it to the car's history and to the visitors of
+ * the lot. Then, it adds a new entry record to the carHistory and keeps it as
+ * the car's last entry, and the time as when the car was last seen.
  * @param car A pointer to the vehicle structure.
  * @param time The date and hour of vehicle entry.
- * @param parkName The name of the parking lot.
+ * @param park The parking lot.
  */
-void putNewEntryInCar(vehicle *car, dateAndHour *time, char *parkName);
+void putNewEntryInCar(vehicle *car, dateAndHour time, parkingLot *park);
 
 /**
  * @brief Adds a new exit record to a vehicle's history.
- * This function searches for the car's history in the parking lot where
- * it is currently parked and adds a new exit record to it.
+ * This function closes the record of the car's last entry, without searching
+ * its history, and keeps the time as when the car was last seen.
  * @param car A pointer to the vehicle structure.
  * @param time The date and hour of vehicle exit.
  * @param fee The fee for parking.
  */
-void putNewExitInCar(vehicle *car, dateAndHour *time, double fee);
+void putNewExitInCar(vehicle *car, dateAndHour time, cents fee);
 
 /**
- * @brief Validates a car plate.
- * This function checks if a car plate is valid. A valid car plate has the
- * format xx-xx-xx, where x can be a digit or an uppercase letter.
- * It must contain at least one digit and one letter.
- * @param carPlate The car plate to validate.
- * @return int: Returns 1 if the car plate is valid, 0 otherwise.
+ * @brief Moves the ticket of a vehicle's last exit to the history store.
+ * The ticket is added as a record linked to the previous stored ticket of
+ * the same history section, and dropped from the section's array. If the
+ * store could not grow, the ticket stays in the array.
+ * @param car A pointer to the vehicle structure, after its exit.
+ * @param store A pointer to the history store.
+ * @param park The number of the park of the exit.
+ * @param journalOffset The offset of the exit in the journal.
  */
-int isValidCarPlate(char *carPlate);
+void storeCarLastTicket(vehicle *car, historyStore *store, unsigned int park,
+    long journalOffset);
+
+/**
+ * @brief Removes the history of a vehicle in a parking lot.
+ * This function unlinks the vehicle's history section of the parking lot and
+ * marks the vehicle as not parked if it is inside that lot. The section
+ * itself and the vehicle's item in the cars of the lot are freed with the lot.
+ * It is used when the parking lot is removed.
+ * @param car A pointer to the vehicle structure.
+ * @param historyItem The item of the section in the vehicle's history.
+ */
+void removeCarHistoryInPark(vehicle *car, info *historyItem);
 
 /**
  * @brief Checks if a vehicle is parked.
@@ -163,24 +309,17 @@ int isCarParked(vehicle *car);
  * last entry time and the specified exit time.
  * @param car A pointer to the vehicle structure.
  * @param exitTime The date and hour of vehicle exit.
- * @return int: The number of minutes the vehicle has been parked.
+ * @return long long: The number of minutes the vehicle has been parked.
  */
-int minutesParked(vehicle *car, dateAndHour *exitTime);
+long long minutesParked(vehicle *car, dateAndHour exitTime);
 
 /**
  * @brief Frees the memory allocated for a vehicle structure.
- * This function frees the memory allocated for the vehicle's parking history
- * and the vehicle structure itself.
+ * This function frees the memory allocated for the vehicle's list of parking
+ * history, if it was not evicted, and the vehicle structure itself. The
+ * history sections belong to the arenas of the parking lots.
  * @param car A pointer to the vehicle structure.
  */
 void freeCar(vehicle *car);
 
-/**
- * @brief Frees the memory allocated for an exitVehicle structure.
- * This function frees the memory allocated for the exit time and the
- * exitVehicle structure itself.
- * @param exit A pointer to the exitVehicle structure.
- */
-void freeExitVehicle(exitVehicle *exit);
-
 #endif